@@ -1,12 +1,85 @@
 #include <iostream>
 #include <iomanip>
+#include <fstream>
+#include <sstream>
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <ctime>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <cstdio>
+#include <cmath>
+#include <charconv>
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
 using namespace std;
 
+const int MINUTES_PER_DAY = 24 * 60;
+
+// Converts "DD/MM/YYYY" into a day number (days since 01/01/1970), -1 if invalid
+int parseDayNumber(const string& date) {
+    int d, m, y;
+    char s1, s2;
+    if (sscanf(date.c_str(), "%d%c%d%c%d", &d, &s1, &m, &s2, &y) != 5 ||
+        s1 != '/' || s2 != '/' || m < 1 || m > 12 || d < 1) {
+        return -1;
+    }
+    static const int monthDays[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leap = y % 4 == 0 && (y % 100 != 0 || y % 400 == 0);
+    if (d > monthDays[m - 1] + (m == 2 && leap)) return -1;
+    y -= m <= 2;
+    int era = (y >= 0 ? y : y - 399) / 400;
+    int yoe = y - era * 400;
+    int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+// Converts "HH:MM" into minutes after midnight, -1 if invalid
+int parseMinutes(const string& time) {
+    int h, m;
+    char sep;
+    if (sscanf(time.c_str(), "%d%c%d", &h, &sep, &m) != 3 || sep != ':' ||
+        h < 0 || h > 23 || m < 0 || m > 59) {
+        return -1;
+    }
+    return h * 60 + m;
+}
+
+// Inverse of parseDayNumber
+string formatDayNumber(int day) {
+    day += 719468;
+    int era = (day >= 0 ? day : day - 146096) / 146097;
+    int doe = day - era * 146097;
+    int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int mp = (5 * doy + 2) / 153;
+    int d = doy - (153 * mp + 2) / 5 + 1;
+    int m = mp + (mp < 10 ? 3 : -9);
+    int y = yoe + era * 400 + (m <= 2);
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%02d/%02d/%04d", d, m, y);
+    return buffer;
+}
+
+void appendNumber(string& out, long long value) {
+    char buffer[24];
+    auto result = to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+string formatMinutes(int minutes) {
+    char buffer[8];
+    snprintf(buffer, sizeof(buffer), "%02d:%02d", (minutes / 60) % 24, minutes % 60);
+    return buffer;
+}
+
 class Passenger {
 private:
     string id;
@@ -34,6 +107,106 @@ public:
     }
 };
 
+// Seat occupancy packed 64 seats per word. Claims and releases are single atomic
+// read-modify-write operations, so agents booking the same flight need no lock.
+class SeatBitmap {
+private:
+    int seatCount;
+    int wordCount;
+    unique_ptr<atomic<uint64_t>[]> words;
+    atomic<int> freeSeats;
+
+    uint64_t validBits(int word) const {
+        int bits = min(64, seatCount - word * 64);
+        return bits == 64 ? ~0ULL : (1ULL << bits) - 1;
+    }
+
+public:
+    explicit SeatBitmap(int seats)
+        : seatCount(seats), wordCount((seats + 63) / 64),
+          words(new atomic<uint64_t>[(seats + 63) / 64]), freeSeats(seats) {
+        for (int i = 0; i < wordCount; i++) words[i].store(0);
+    }
+
+    // Copies are only made while the owning container reallocates, never during booking
+    SeatBitmap(const SeatBitmap& other)
+        : seatCount(other.seatCount), wordCount(other.wordCount),
+          words(new atomic<uint64_t>[other.wordCount]), freeSeats(other.freeSeats.load()) {
+        for (int i = 0; i < wordCount; i++) words[i].store(other.words[i].load());
+    }
+
+    SeatBitmap& operator=(const SeatBitmap& other) {
+        if (this != &other) {
+            seatCount = other.seatCount;
+            wordCount = other.wordCount;
+            words.reset(new atomic<uint64_t>[wordCount]);
+            for (int i = 0; i < wordCount; i++) words[i].store(other.words[i].load());
+            freeSeats.store(other.freeSeats.load());
+        }
+        return *this;
+    }
+
+    int size() const { return seatCount; }
+    int available() const { return freeSeats.load(memory_order_relaxed); }
+
+    bool isOccupied(int idx) const {
+        return (words[idx / 64].load(memory_order_acquire) >> (idx % 64)) & 1;
+    }
+
+    // Only the caller whose CAS flips the bit from 0 to 1 owns the seat
+    bool claim(int idx) {
+        atomic<uint64_t>& word = words[idx / 64];
+        uint64_t mask = 1ULL << (idx % 64);
+        uint64_t current = word.load(memory_order_relaxed);
+        while (!(current & mask)) {
+            if (word.compare_exchange_weak(current, current | mask, memory_order_acq_rel)) {
+                freeSeats.fetch_sub(1, memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool release(int idx) {
+        atomic<uint64_t>& word = words[idx / 64];
+        uint64_t mask = 1ULL << (idx % 64);
+        uint64_t current = word.load(memory_order_relaxed);
+        while (current & mask) {
+            if (word.compare_exchange_weak(current, current & ~mask, memory_order_acq_rel)) {
+                freeSeats.fetch_add(1, memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Claims the first free seat at or after the hint's word, wrapping around;
+    // different hints spread agents across words to reduce CAS contention.
+    int claimAny(int hint) {
+        int startWord = wordCount ? (hint / 64) % wordCount : 0;
+        for (int n = 0; n < wordCount && available() > 0; n++) {
+            int w = (startWord + n) % wordCount;
+            uint64_t current = words[w].load(memory_order_relaxed);
+            uint64_t freeBits = ~current & validBits(w);
+            while (freeBits) {
+                uint64_t bit = freeBits & (~freeBits + 1);
+                if (words[w].compare_exchange_weak(current, current | bit, memory_order_acq_rel)) {
+                    freeSeats.fetch_sub(1, memory_order_relaxed);
+                    return w * 64 + __builtin_ctzll(bit);
+                }
+                freeBits = ~current & validBits(w);
+            }
+        }
+        return -1;
+    }
+};
+
+struct FareClass {
+    string code;
+    double price;
+    int bookingLimit;  // seats this class and every class after it may sell together
+};
+
 class Flight {
 private:
     string flightNumber;
@@ -44,45 +217,170 @@ private:
     string arrivalTime;
     double price;
     int totalSeats;
-    int availableSeats;
-    vector<bool> seatMap;  // true if seat is occupied
-    map<int, string> seatAssignments;  // seat number -> passenger ID
+    SeatBitmap seatMap;
+    vector<string> seatAssignments;  // seat number - 1 -> passenger ID, written by the seat's owner
+
+    // Nested fare-class inventory, ordered from the most to the least expensive
+    // class. Fare accounting belongs to the booking desk path and, unlike the
+    // seat claims, is not safe for concurrent agents; seats claimed without a
+    // class (fareClass -1) still count through the physical seat limit.
+    vector<FareClass> fareClasses;
+    vector<int> fareRemaining;      // bookingLimit - seats sold in this and later classes
+    vector<int> fareAvailability;   // prefix minimum of fareRemaining, the cached answer
+    vector<int8_t> seatClass;       // fare class of each booked seat, -1 if none
+
+    void refreshFareAvailability() {
+        int best = totalSeats;
+        for (size_t c = 0; c < fareClasses.size(); c++) {
+            best = min(best, fareRemaining[c]);
+            fareAvailability[c] = best;
+        }
+    }
+
+    // A sale in class c consumes nested capacity of c and of every class above it
+    void recordFareSale(int fareClass, int delta) {
+        for (int c = 0; c <= fareClass; c++) fareRemaining[c] -= delta;
+        refreshFareAvailability();
+    }
 
 public:
     Flight(string fNumber, string from, string to, string date, 
            string depTime, string arrTime, double ticketPrice, int seats)
         : flightNumber(fNumber), origin(from), destination(to),
           departureDate(date), departureTime(depTime), arrivalTime(arrTime),
-          price(ticketPrice), totalSeats(seats), availableSeats(seats) {
-        seatMap.resize(totalSeats, false);
+          price(ticketPrice), totalSeats(seats), seatMap(seats), seatAssignments(seats),
+          seatClass(seats, -1) {
+        setFareClasses({{"Y", ticketPrice, seats}});
     }
 
     string getFlightNumber() const { return flightNumber; }
     string getOrigin() const { return origin; }
     string getDestination() const { return destination; }
     string getDepartureDate() const { return departureDate; }
+    string getDepartureTime() const { return departureTime; }
+    string getArrivalTime() const { return arrivalTime; }
     double getPrice() const { return price; }
-    int getAvailableSeats() const { return availableSeats; }
+    int getTotalSeats() const { return totalSeats; }
+    int getAvailableSeats() const { return seatMap.available(); }
 
     bool isSeatAvailable(int seatNumber) const {
-        return seatNumber > 0 && seatNumber <= totalSeats && !seatMap[seatNumber - 1];
+        return seatNumber > 0 && seatNumber <= totalSeats && !seatMap.isOccupied(seatNumber - 1);
+    }
+
+    // Replaces the fare structure; only allowed before any seat is sold and
+    // booking limits must not increase from one class to the next
+    bool setFareClasses(const vector<FareClass>& classes) {
+        if (classes.empty() || classes.size() > 16 || getAvailableSeats() != totalSeats) return false;
+        for (size_t c = 0; c < classes.size(); c++) {
+            if (classes[c].bookingLimit < 0 || classes[c].bookingLimit > totalSeats ||
+                (c > 0 && classes[c].bookingLimit > classes[c - 1].bookingLimit)) {
+                return false;
+            }
+        }
+        fareClasses = classes;
+        fareRemaining.clear();
+        for (const auto& fare : fareClasses) fareRemaining.push_back(fare.bookingLimit);
+        fareAvailability.assign(fareClasses.size(), 0);
+        refreshFareAvailability();
+        return true;
+    }
+
+    const vector<FareClass>& getFareClasses() const { return fareClasses; }
+
+    int findFareClass(const string& code) const {
+        for (size_t c = 0; c < fareClasses.size(); c++) {
+            if (fareClasses[c].code == code) return c;
+        }
+        return -1;
+    }
+
+    // Served from the cache; never touches the seat map
+    int getFareAvailability(int fareClass) const {
+        return min(fareAvailability[fareClass], getAvailableSeats());
+    }
+
+    // Cheapest class that still has a seat to sell, -1 if none
+    int cheapestOpenFareClass() const {
+        int best = -1;
+        for (size_t c = 0; c < fareClasses.size(); c++) {
+            if (getFareAvailability(c) > 0 &&
+                (best < 0 || fareClasses[c].price < fareClasses[best].price)) {
+                best = c;
+            }
+        }
+        return best;
+    }
+
+    // Availability recomputed from the booked seats, used to verify the cache
+    int recountFareAvailability(int fareClass) const {
+        vector<int> soldInClass(fareClasses.size(), 0);
+        for (int i = 0; i < totalSeats; i++) {
+            if (seatMap.isOccupied(i) && seatClass[i] >= 0) soldInClass[seatClass[i]]++;
+        }
+        int best = getAvailableSeats(), soldBelow = 0;
+        for (int c = fareClasses.size() - 1; c >= 0; c--) {
+            soldBelow += soldInClass[c];
+            if (c <= fareClass) best = min(best, fareClasses[c].bookingLimit - soldBelow);
+        }
+        return best;
     }
 
-    bool assignSeat(int seatNumber, const string& passengerId) {
-        if (isSeatAvailable(seatNumber)) {
-            seatMap[seatNumber - 1] = true;
-            seatAssignments[seatNumber] = passengerId;
-            availableSeats--;
+    // Safe to call from many booking agents at once when fareClass is -1
+    bool assignSeat(int seatNumber, const string& passengerId, int fareClass = -1) {
+        if (fareClass >= 0 && getFareAvailability(fareClass) <= 0) {
+            return false;
+        }
+        if (seatNumber > 0 && seatNumber <= totalSeats && seatMap.claim(seatNumber - 1)) {
+            seatAssignments[seatNumber - 1] = passengerId;
+            seatClass[seatNumber - 1] = fareClass;
+            if (fareClass >= 0) recordFareSale(fareClass, 1);
             return true;
         }
         return false;
     }
 
+    // Books the first free seat near the hint; returns the seat number or 0 if sold out
+    int assignAnySeat(const string& passengerId, int hint = 0, int fareClass = -1) {
+        if (fareClass >= 0 && getFareAvailability(fareClass) <= 0) {
+            return 0;
+        }
+        int idx = seatMap.claimAny(hint);
+        if (idx < 0) return 0;
+        seatAssignments[idx] = passengerId;
+        seatClass[idx] = fareClass;
+        if (fareClass >= 0) recordFareSale(fareClass, 1);
+        return idx + 1;
+    }
+
+    // Moves a booking to another seat, keeping its fare class
+    bool moveSeat(int fromSeat, int toSeat) {
+        if (fromSeat <= 0 || fromSeat > totalSeats || !seatMap.isOccupied(fromSeat - 1) ||
+            toSeat <= 0 || toSeat > totalSeats || !seatMap.claim(toSeat - 1)) {
+            return false;
+        }
+        seatAssignments[toSeat - 1] = seatAssignments[fromSeat - 1];
+        seatClass[toSeat - 1] = seatClass[fromSeat - 1];
+        seatAssignments[fromSeat - 1].clear();
+        seatClass[fromSeat - 1] = -1;
+        return seatMap.release(fromSeat - 1);
+    }
+
+    int getSeatFareClass(int seatNumber) const {
+        return seatNumber > 0 && seatNumber <= totalSeats ? seatClass[seatNumber - 1] : -1;
+    }
+
+    string getSeatPassenger(int seatNumber) const {
+        return seatNumber > 0 && seatNumber <= totalSeats ? seatAssignments[seatNumber - 1] : "";
+    }
+
+    // Must only be called by the holder of the seat
     bool cancelSeat(int seatNumber) {
-        if (seatNumber > 0 && seatNumber <= totalSeats && seatMap[seatNumber - 1]) {
-            seatMap[seatNumber - 1] = false;
-            seatAssignments.erase(seatNumber);
-            availableSeats++;
+        if (seatNumber > 0 && seatNumber <= totalSeats && seatMap.isOccupied(seatNumber - 1)) {
+            int fareClass = seatClass[seatNumber - 1];
+            seatAssignments[seatNumber - 1].clear();
+            seatClass[seatNumber - 1] = -1;
+            if (!seatMap.release(seatNumber - 1)) return false;
+            if (fareClass >= 0) recordFareSale(fareClass, -1);
             return true;
         }
         return false;
@@ -90,19 +388,83 @@ public:
 
     void displaySeatMap() const {
         cout << "\nSeat Map for Flight " << flightNumber << ":" << endl;
-        cout << "Available Seats: " << availableSeats << "/" << totalSeats << endl;
+        cout << "Available Seats: " << getAvailableSeats() << "/" << totalSeats << endl;
         
         int seatsPerRow = 6;
         for (int i = 0; i < totalSeats; i++) {
             if (i % seatsPerRow == 0) {
                 cout << "\nRow " << (i / seatsPerRow + 1) << ": ";
             }
-            cout << (seatMap[i] ? "X" : "O") << " ";
+            cout << (seatMap.isOccupied(i) ? "X" : "O") << " ";
         }
         cout << "\nX = Occupied, O = Available" << endl;
     }
 
+    // Appends the flight details, as printed by displayInfo, to out without iostreams
+    void renderInfo(string& out) const {
+        char priceText[32];
+        snprintf(priceText, sizeof(priceText), "%.2f", price);
+        out += "\nFlight Details:\nFlight Number: ";
+        out += flightNumber;
+        out += "\nRoute: ";
+        out += origin;
+        out += " -> ";
+        out += destination;
+        out += "\nDate: ";
+        out += departureDate;
+        out += "\nDeparture Time: ";
+        out += departureTime;
+        out += "\nArrival Time: ";
+        out += arrivalTime;
+        out += "\nPrice: ETB ";
+        out += priceText;
+        out += "\nAvailable Seats: ";
+        appendNumber(out, getAvailableSeats());
+        out += '/';
+        appendNumber(out, totalSeats);
+        out += '\n';
+        if (fareClasses.size() > 1) {
+            for (size_t c = 0; c < fareClasses.size(); c++) {
+                snprintf(priceText, sizeof(priceText), "%.2f", fareClasses[c].price);
+                out += "  Class ";
+                out += fareClasses[c].code;
+                out += ": ETB ";
+                out += priceText;
+                out += ", ";
+                appendNumber(out, getFareAvailability(c));
+                out += " available\n";
+            }
+        }
+    }
+
+    // Appends the seat rows and legend to out
+    void renderSeatMap(string& out) const {
+        int seatsPerRow = 6;
+        for (int i = 0; i < totalSeats; i++) {
+            if (i % seatsPerRow == 0) {
+                out += "\nRow ";
+                appendNumber(out, i / seatsPerRow + 1);
+                out += ": ";
+            }
+            out += seatMap.isOccupied(i) ? "X " : "O ";
+        }
+        out += "\nX = Occupied, O = Available\n";
+    }
+
+    // Rough upper bound of the rendered size, used to pre-size export buffers
+    size_t renderSizeHint() const {
+        return 512 + fareClasses.size() * 64 + totalSeats * 2 + (totalSeats / 6 + 1) * 12 +
+               (totalSeats - getAvailableSeats()) * 96;
+    }
+
     void displayInfo() const {
+        string out;
+        renderInfo(out);
+        cout << out << flush;
+    }
+
+    // The iostream displayInfo that renderInfo replaced, kept for benchmarking
+    void displayInfoByStream() const {
         cout << "\nFlight Details:" << endl;
         cout << "Flight Number: " << flightNumber << endl;
         cout << "Route: " << origin << " -> " << destination << endl;
@@ -110,7 +472,13 @@ public:
         cout << "Departure Time: " << departureTime << endl;
         cout << "Arrival Time: " << arrivalTime << endl;
         cout << "Price: ETB " << fixed << setprecision(2) << price << endl;
-        cout << "Available Seats: " << availableSeats << "/" << totalSeats << endl;
+        cout << "Available Seats: " << getAvailableSeats() << "/" << totalSeats << endl;
+        if (fareClasses.size() > 1) {
+            for (size_t c = 0; c < fareClasses.size(); c++) {
+                cout << "  Class " << fareClasses[c].code << ": ETB " << fareClasses[c].price
+                     << ", " << getFareAvailability(c) << " available" << endl;
+            }
+        }
     }
 };
 
@@ -120,23 +488,32 @@ private:
     string passengerId;
     string flightNumber;
     int seatNumber;
+    string fareCode;
     time_t bookingTime;
     bool confirmed;
+    bool cancelled;
 
 public:
-    Reservation(string resNumber, string pId, string fNumber, int seat)
+    Reservation(string resNumber, string pId, string fNumber, int seat, string fare = "Y",
+                time_t bookedAt = time(0))
         : reservationNumber(resNumber), passengerId(pId),
-          flightNumber(fNumber), seatNumber(seat),
-          bookingTime(time(0)), confirmed(false) {}
+          flightNumber(fNumber), seatNumber(seat), fareCode(fare),
+          bookingTime(bookedAt), confirmed(false), cancelled(false) {}
 
     string getReservationNumber() const { return reservationNumber; }
     string getPassengerId() const { return passengerId; }
     string getFlightNumber() const { return flightNumber; }
     int getSeatNumber() const { return seatNumber; }
+    string getFareCode() const { return fareCode; }
     bool isConfirmed() const { return confirmed; }
+    bool isCancelled() const { return cancelled; }
 
     void confirm() { confirmed = true; }
-    void cancel() { confirmed = false; }
+    void changeSeat(int seat) { seatNumber = seat; }
+    void cancel() {
+        confirmed = false;
+        cancelled = true;
+    }
 
     void displayInfo() const {
         cout << "\nReservation Details:" << endl;
@@ -144,26 +521,632 @@ public:
         cout << "Flight Number: " << flightNumber << endl;
         cout << "Passenger ID: " << passengerId << endl;
         cout << "Seat Number: " << seatNumber << endl;
-        cout << "Status: " << (confirmed ? "Confirmed" : "Pending") << endl;
+        cout << "Fare Class: " << fareCode << endl;
+        cout << "Status: " << (cancelled ? "Cancelled" : confirmed ? "Confirmed" : "Pending") << endl;
         cout << "Booking Time: " << ctime(&bookingTime);
     }
 };
 
+enum class ReservationEventType { Book, Cancel, ChangeSeat };
+
+struct ReservationEvent {
+    uint64_t sequence;
+    time_t timestamp;
+    ReservationEventType type;
+    string flightNumber;
+    int seatNumber;     // seat held after the event (released seat for Cancel)
+    int previousSeat;   // only used by ChangeSeat
+    string reservationNumber;
+    string passengerId;
+    string fareCode;
+};
+
+// Append-only history of seat-changing reservation events. Every flight keeps
+// occupancy checkpoints so a point-in-time seat map only replays the tail.
+class ReservationLog {
+private:
+    struct SeatMapCheckpoint {
+        size_t eventsApplied;  // how many of the flight's events are folded in
+        time_t timestamp;
+        vector<uint64_t> words;
+    };
+
+    struct FlightHistory {
+        int seatCount;
+        vector<size_t> events;  // positions in the global log
+        vector<uint64_t> current;
+        vector<SeatMapCheckpoint> checkpoints;
+    };
+
+    vector<ReservationEvent> events;
+    unordered_map<string, FlightHistory> histories;
+    size_t checkpointInterval;
+
+    static void applyEvent(vector<uint64_t>& words, const ReservationEvent& event) {
+        auto set = [&](int seat, bool occupied) {
+            uint64_t mask = 1ULL << ((seat - 1) % 64);
+            if (occupied) words[(seat - 1) / 64] |= mask;
+            else words[(seat - 1) / 64] &= ~mask;
+        };
+        switch (event.type) {
+            case ReservationEventType::Book:
+                set(event.seatNumber, true);
+                break;
+            case ReservationEventType::Cancel:
+                set(event.seatNumber, false);
+                break;
+            case ReservationEventType::ChangeSeat:
+                set(event.previousSeat, false);
+                set(event.seatNumber, true);
+                break;
+        }
+    }
+
+    static char typeCode(ReservationEventType type) {
+        return type == ReservationEventType::Book ? 'B' :
+               type == ReservationEventType::Cancel ? 'C' : 'S';
+    }
+
+public:
+    explicit ReservationLog(size_t interval = 128) : checkpointInterval(interval) {}
+
+    void trackFlight(const string& flightNumber, int seatCount) {
+        FlightHistory& history = histories[flightNumber];
+        history.seatCount = seatCount;
+        history.current.assign((seatCount + 63) / 64, 0);
+        history.checkpoints.push_back({0, 0, history.current});
+    }
+
+    // Timestamps never run backwards, so every history stays sorted by time
+    const ReservationEvent& append(ReservationEventType type, const string& flightNumber,
+                                   int seatNumber, int previousSeat,
+                                   const string& reservationNumber, const string& passengerId,
+                                   const string& fareCode, time_t timestamp = time(0)) {
+        if (!events.empty()) timestamp = max(timestamp, events.back().timestamp);
+        events.push_back({events.size() + 1, timestamp, type, flightNumber, seatNumber,
+                          previousSeat, reservationNumber, passengerId, fareCode});
+
+        FlightHistory& history = histories.at(flightNumber);
+        history.events.push_back(events.size() - 1);
+        applyEvent(history.current, events.back());
+        if (history.events.size() % checkpointInterval == 0) {
+            history.checkpoints.push_back({history.events.size(), timestamp, history.current});
+        }
+        return events.back();
+    }
+
+    // Occupancy of every seat as it was at the end of the given second
+    vector<bool> seatMapAt(const string& flightNumber, time_t when) const {
+        auto it = histories.find(flightNumber);
+        if (it == histories.end()) return {};
+        const FlightHistory& history = it->second;
+
+        auto checkpoint = upper_bound(history.checkpoints.begin() + 1, history.checkpoints.end(), when,
+            [](time_t t, const SeatMapCheckpoint& cp) { return t < cp.timestamp; }) - 1;
+        vector<uint64_t> words = checkpoint->words;
+        for (size_t i = checkpoint->eventsApplied; i < history.events.size(); i++) {
+            const ReservationEvent& event = events[history.events[i]];
+            if (event.timestamp > when) break;
+            applyEvent(words, event);
+        }
+
+        vector<bool> occupied(history.seatCount);
+        for (int seat = 0; seat < history.seatCount; seat++) {
+            occupied[seat] = (words[seat / 64] >> (seat % 64)) & 1;
+        }
+        return occupied;
+    }
+
+    size_t size() const { return events.size(); }
+
+    // One event as an "E ..." line, without the newline
+    static string formatEvent(const ReservationEvent& event) {
+        ostringstream out;
+        out << "E " << event.sequence << " " << (long long)event.timestamp << " "
+            << typeCode(event.type) << " " << event.flightNumber << " " << event.seatNumber
+            << " " << event.previousSeat << " " << event.reservationNumber << " "
+            << event.passengerId << " " << event.fareCode;
+        return out.str();
+    }
+
+    // Inverse of formatEvent; false if the line is malformed
+    static bool parseEvent(const string& line, ReservationEvent& event) {
+        istringstream fields(line);
+        string tag;
+        long long timestamp;
+        char code;
+        if (!(fields >> tag >> event.sequence >> timestamp >> code >> event.flightNumber >> event.seatNumber
+                     >> event.previousSeat >> event.reservationNumber >> event.passengerId >> event.fareCode) ||
+            tag != "E" || (code != 'B' && code != 'C' && code != 'S')) {
+            return false;
+        }
+        event.timestamp = time_t(timestamp);
+        event.type = code == 'B' ? ReservationEventType::Book :
+                     code == 'C' ? ReservationEventType::Cancel : ReservationEventType::ChangeSeat;
+        return true;
+    }
+
+    void writeTo(ostream& out) const {
+        for (const auto& entry : histories) {
+            out << "F " << entry.first << " " << entry.second.seatCount << "\n";
+        }
+        for (const auto& event : events) {
+            out << formatEvent(event) << "\n";
+        }
+    }
+};
+
+// One flight in the route index; times are absolute minutes since 01/01/1970
+struct FlightLeg {
+    int flightIdx;
+    int origin;
+    int destination;
+    int departure;
+    int arrival;
+    double price;
+};
+
+struct Itinerary {
+    vector<int> flights;  // flight indices in travel order
+    int departure;
+    int arrival;
+    double totalPrice;
+};
+
+class RouteIndex {
+private:
+    unordered_map<string, int> airportIds;
+    vector<string> airportCodes;
+    vector<FlightLeg> legs;
+    unordered_map<uint64_t, vector<int>> routeDayFlights;  // (origin, destination, day) -> legs
+    vector<vector<int>> departures;  // airport -> legs sorted by departure
+    bool departuresSorted;
+
+    static uint64_t routeDayKey(int origin, int destination, int day) {
+        return (uint64_t(uint32_t(origin)) << 44) | (uint64_t(uint32_t(destination)) << 24) |
+               uint64_t(uint32_t(day) & 0xFFFFFF);
+    }
+
+    void sortDepartures() {
+        for (auto& list : departures) {
+            sort(list.begin(), list.end(), [&](int a, int b) {
+                return legs[a].departure < legs[b].departure;
+            });
+        }
+        departuresSorted = true;
+    }
+
+    // Depth-first walk over the time-expanded graph: each step may only take a
+    // departure inside the layover window of the previous arrival.
+    void extend(vector<int>& path, int destination, int legsLeft, int minLayover,
+                int maxLayover, vector<Itinerary>& results) const {
+        const FlightLeg& last = legs[path.back()];
+        if (last.destination == destination) {
+            Itinerary itinerary;
+            itinerary.departure = legs[path.front()].departure;
+            itinerary.arrival = last.arrival;
+            itinerary.totalPrice = 0;
+            for (int leg : path) {
+                itinerary.flights.push_back(legs[leg].flightIdx);
+                itinerary.totalPrice += legs[leg].price;
+            }
+            results.push_back(itinerary);
+            return;
+        }
+        if (legsLeft == 0) return;
+
+        const vector<int>& outbound = departures[last.destination];
+        int earliest = last.arrival + minLayover;
+        int latest = last.arrival + maxLayover;
+        auto it = lower_bound(outbound.begin(), outbound.end(), earliest,
+            [&](int leg, int time) { return legs[leg].departure < time; });
+        for (; it != outbound.end() && legs[*it].departure <= latest; ++it) {
+            int next = legs[*it].destination;
+            bool revisits = legs[path.front()].origin == next;
+            for (int leg : path) revisits = revisits || legs[leg].destination == next;
+            if (revisits) continue;
+
+            path.push_back(*it);
+            extend(path, destination, legsLeft - 1, minLayover, maxLayover, results);
+            path.pop_back();
+        }
+    }
+
+public:
+    RouteIndex() : departuresSorted(true) {}
+
+    int internAirport(const string& code) {
+        auto it = airportIds.find(code);
+        if (it != airportIds.end()) return it->second;
+        int id = airportCodes.size();
+        airportIds.emplace(code, id);
+        airportCodes.push_back(code);
+        departures.emplace_back();
+        return id;
+    }
+
+    int findAirport(const string& code) const {
+        auto it = airportIds.find(code);
+        return it == airportIds.end() ? -1 : it->second;
+    }
+
+    void addFlight(int flightIdx, const string& origin, const string& destination,
+                   int day, int depMinutes, int arrMinutes, double price) {
+        FlightLeg leg;
+        leg.flightIdx = flightIdx;
+        leg.origin = internAirport(origin);
+        leg.destination = internAirport(destination);
+        leg.departure = day * MINUTES_PER_DAY + depMinutes;
+        // Arrival times earlier than departure land on the next day
+        leg.arrival = day * MINUTES_PER_DAY + arrMinutes +
+                      (arrMinutes < depMinutes ? MINUTES_PER_DAY : 0);
+        leg.price = price;
+
+        int legIdx = legs.size();
+        legs.push_back(leg);
+        routeDayFlights[routeDayKey(leg.origin, leg.destination, day)].push_back(flightIdx);
+        departures[leg.origin].push_back(legIdx);
+        departuresSorted = false;
+    }
+
+    vector<int> directFlights(const string& origin, const string& destination, int day) const {
+        int from = findAirport(origin), to = findAirport(destination);
+        if (from < 0 || to < 0 || day < 0) return {};
+        auto it = routeDayFlights.find(routeDayKey(from, to, day));
+        return it == routeDayFlights.end() ? vector<int>() : it->second;
+    }
+
+    // Itineraries leaving on the given day with up to maxConnections stops,
+    // ranked by arrival time (or by total price) and trimmed to limit. With
+    // connectionsOnly, direct flights are dropped before the limit applies.
+    vector<Itinerary> findItineraries(const string& origin, const string& destination, int day,
+                                      int maxConnections, int minLayover, int maxLayover,
+                                      bool rankByPrice, size_t limit, bool connectionsOnly = false) {
+        vector<Itinerary> results;
+        int from = findAirport(origin), to = findAirport(destination);
+        if (from < 0 || to < 0 || from == to || day < 0) return results;
+        if (!departuresSorted) sortDepartures();
+
+        const vector<int>& outbound = departures[from];
+        int dayStart = day * MINUTES_PER_DAY;
+        auto it = lower_bound(outbound.begin(), outbound.end(), dayStart,
+            [&](int leg, int time) { return legs[leg].departure < time; });
+        vector<int> path;
+        for (; it != outbound.end() && legs[*it].departure < dayStart + MINUTES_PER_DAY; ++it) {
+            path.assign(1, *it);
+            extend(path, to, maxConnections, minLayover, maxLayover, results);
+        }
+        if (connectionsOnly) {
+            results.erase(remove_if(results.begin(), results.end(),
+                [](const Itinerary& itinerary) { return itinerary.flights.size() < 2; }), results.end());
+        }
+
+        auto byArrival = [](const Itinerary& a, const Itinerary& b) {
+            if (a.arrival != b.arrival) return a.arrival < b.arrival;
+            return a.totalPrice < b.totalPrice;
+        };
+        auto byPrice = [](const Itinerary& a, const Itinerary& b) {
+            if (a.totalPrice != b.totalPrice) return a.totalPrice < b.totalPrice;
+            return a.arrival < b.arrival;
+        };
+        size_t keep = min(limit, results.size());
+        if (rankByPrice) {
+            partial_sort(results.begin(), results.begin() + keep, results.end(), byPrice);
+        } else {
+            partial_sort(results.begin(), results.begin() + keep, results.end(), byArrival);
+        }
+        results.resize(keep);
+        return results;
+    }
+
+    size_t airportCount() const { return airportCodes.size(); }
+};
+
+// Schedule stored column by column and sorted by (origin, destination, day), so
+// a flexible-date fare query is a binary search plus a tight filter loop over
+// a few contiguous arrays instead of a scan over Flight objects.
+class ColumnarSchedule {
+private:
+    vector<uint64_t> routeDay;  // sort key: origin, destination, day
+    vector<int32_t> day;
+    vector<int16_t> departure;  // minutes after midnight
+    vector<double> price;
+    vector<int32_t> seats;
+    vector<int32_t> flightIdx;
+    vector<int32_t> rowOfFlight;
+    bool sorted;
+
+    static const int MAX_KEY_DAY = 0xFFFFFF;
+
+    static uint64_t key(int origin, int destination, int dayNumber) {
+        return (uint64_t(uint32_t(origin)) << 44) | (uint64_t(uint32_t(destination)) << 24) |
+               uint64_t(uint32_t(dayNumber) & MAX_KEY_DAY);
+    }
+
+    template <typename T>
+    static void permute(vector<T>& column, const vector<int32_t>& order) {
+        vector<T> result(column.size());
+        for (size_t i = 0; i < order.size(); i++) result[i] = column[order[i]];
+        column.swap(result);
+    }
+
+    void sortRows() {
+        vector<int32_t> order(routeDay.size());
+        for (size_t i = 0; i < order.size(); i++) order[i] = i;
+        sort(order.begin(), order.end(), [&](int32_t a, int32_t b) {
+            if (routeDay[a] != routeDay[b]) return routeDay[a] < routeDay[b];
+            return departure[a] < departure[b];
+        });
+        permute(routeDay, order);
+        permute(day, order);
+        permute(departure, order);
+        permute(price, order);
+        permute(seats, order);
+        permute(flightIdx, order);
+        for (size_t row = 0; row < flightIdx.size(); row++) rowOfFlight[flightIdx[row]] = row;
+        sorted = true;
+    }
+
+public:
+    ColumnarSchedule() : sorted(true) {}
+
+    void reserve(size_t rows) {
+        routeDay.reserve(rows);
+        day.reserve(rows);
+        departure.reserve(rows);
+        price.reserve(rows);
+        seats.reserve(rows);
+        flightIdx.reserve(rows);
+        rowOfFlight.reserve(rows);
+    }
+
+    // Flight indices must be dense and added in order
+    void add(int flight, int origin, int destination, int dayNumber, int depMinutes,
+             double ticketPrice, int availableSeats) {
+        rowOfFlight.push_back(routeDay.size());
+        routeDay.push_back(key(origin, destination, dayNumber));
+        day.push_back(dayNumber);
+        departure.push_back(depMinutes);
+        price.push_back(ticketPrice);
+        seats.push_back(availableSeats);
+        flightIdx.push_back(flight);
+        sorted = false;
+    }
+
+    void updateSeats(int flight, int availableSeats) {
+        seats[rowOfFlight[flight]] = availableSeats;
+    }
+
+    // Flights within dayNumber +/- flexDays priced at most maxPrice with at least
+    // minSeats left, cheapest first
+    vector<int> search(int origin, int destination, int dayNumber, int flexDays,
+                       double maxPrice, int minSeats) {
+        if (!sorted) sortRows();
+        if (flexDays < 0) return {};
+        // Bounds in 64 bits, clamped to the 24 day bits of the key, so a huge
+        // flexDays covers the whole schedule instead of overflowing or wrapping
+        long long firstDay = max(0LL, (long long)dayNumber - flexDays);
+        long long lastDay = min((long long)MAX_KEY_DAY, (long long)dayNumber + flexDays);
+        if (lastDay < firstDay) return {};
+        size_t lo = lower_bound(routeDay.begin(), routeDay.end(),
+                                key(origin, destination, firstDay)) - routeDay.begin();
+        size_t hi = upper_bound(routeDay.begin(), routeDay.end(),
+                                key(origin, destination, lastDay)) - routeDay.begin();
+        if (hi <= lo) return {};
+
+        // Branch-free compaction keeps the filter loop vectorizable
+        vector<int32_t> rows(hi - lo);
+        size_t count = 0;
+        for (size_t r = lo; r < hi; r++) {
+            rows[count] = r;
+            count += (price[r] <= maxPrice) & (seats[r] >= minSeats);
+        }
+        rows.resize(count);
+        sort(rows.begin(), rows.end(), [&](int32_t a, int32_t b) {
+            if (price[a] != price[b]) return price[a] < price[b];
+            return routeDay[a] != routeDay[b] ? routeDay[a] < routeDay[b] : departure[a] < departure[b];
+        });
+
+        vector<int> result;
+        result.reserve(count);
+        for (int32_t r : rows) result.push_back(flightIdx[r]);
+        return result;
+    }
+
+    size_t size() const { return routeDay.size(); }
+};
+
 class AirlineReservationSystem {
 private:
     vector<Flight> flights;
     vector<Passenger> passengers;
     vector<Reservation> reservations;
     map<string, int> flightIndex;    // flightNumber -> index
-    map<string, int> passengerIndex; // passengerId -> index
+    unordered_map<string, int> passengerIndex; // passengerId -> index
+    RouteIndex routes;
+    ColumnarSchedule schedule;
+    unordered_map<int, vector<int>> flightsByDay;  // day number -> flight indices
     int lastReservationNumber;
 
+    // Reservation indexes hold positions in reservations; cancelled entries stay
+    // in place as tombstones until compactReservations() drops them.
+    unordered_map<string, size_t> reservationIndex;
+    unordered_map<string, vector<size_t>> reservationsByPassenger;
+    unordered_map<string, vector<size_t>> reservationsByFlight;
+    size_t cancelledReservations;
+    ReservationLog eventLog;
+    ofstream journal;  // every change, one line each, replayed by openJournal
+
+    static const size_t COMPACTION_MIN_TOMBSTONES = 1024;
+
+    static const int MAX_CONNECTIONS = 2;
+    static const int MIN_LAYOVER_MINUTES = 45;
+    static const int MAX_LAYOVER_MINUTES = 12 * 60;
+
     string generateReservationNumber() {
         return "RES" + to_string(++lastReservationNumber);
     }
 
+    // The number after "RES" in a generated reservation number, -1 if malformed
+    static int reservationSerial(const string& reservationNumber) {
+        if (reservationNumber.size() <= 3 || reservationNumber.compare(0, 3, "RES") != 0) return -1;
+        int serial;
+        const char* end = reservationNumber.data() + reservationNumber.size();
+        auto parsed = from_chars(reservationNumber.data() + 3, end, serial);
+        return parsed.ec == errc() && parsed.ptr == end && serial >= 0 ? serial : -1;
+    }
+
+    void syncSeats(const string& flightNumber) {
+        int idx = flightIndex.at(flightNumber);
+        schedule.updateSeats(idx, flights[idx].getAvailableSeats());
+    }
+
+    void indexReservation(size_t pos) {
+        const Reservation& res = reservations[pos];
+        reservationIndex[res.getReservationNumber()] = pos;
+        reservationsByPassenger[res.getPassengerId()].push_back(pos);
+        reservationsByFlight[res.getFlightNumber()].push_back(pos);
+    }
+
+    void journalLine(const string& line) {
+        if (journal.is_open()) journal << line << '\n' << flush;
+    }
+
+    const ReservationEvent& logEvent(ReservationEventType type, const string& flightNumber, int seatNumber,
+                                     int previousSeat, const string& reservationNumber,
+                                     const string& passengerId, const string& fareCode,
+                                     time_t timestamp = time(0)) {
+        const ReservationEvent& event = eventLog.append(type, flightNumber, seatNumber, previousSeat,
+                                                        reservationNumber, passengerId, fareCode, timestamp);
+        journalLine(ReservationLog::formatEvent(event));
+        return event;
+    }
+
+    static vector<string> splitFields(const string& line) {
+        vector<string> fields;
+        istringstream in(line);
+        string field;
+        while (getline(in, field, '\t')) fields.push_back(field);
+        return fields;
+    }
+
+    // Applies a logged event the way the original call did; false if the
+    // seat or reservation it names is not in the state the event expects
+    bool replayEvent(const ReservationEvent& event) {
+        auto flightIt = flightIndex.find(event.flightNumber);
+        if (flightIt == flightIndex.end()) return false;
+        Flight& flight = flights[flightIt->second];
+
+        if (event.type == ReservationEventType::Book) {
+            int fareClass = flight.findFareClass(event.fareCode);
+            int serial = reservationSerial(event.reservationNumber);
+            if (fareClass < 0 || serial < 0 ||
+                reservationIndex.find(event.reservationNumber) != reservationIndex.end() ||
+                !flight.assignSeat(event.seatNumber, event.passengerId, fareClass)) {
+                return false;
+            }
+            reservations.emplace_back(event.reservationNumber, event.passengerId, event.flightNumber,
+                                      event.seatNumber, event.fareCode, event.timestamp);
+            reservations.back().confirm();
+            indexReservation(reservations.size() - 1);
+            lastReservationNumber = max(lastReservationNumber, serial);
+        } else {
+            auto resIt = reservationIndex.find(event.reservationNumber);
+            if (resIt == reservationIndex.end() || reservations[resIt->second].isCancelled()) return false;
+            Reservation& res = reservations[resIt->second];
+            if (event.type == ReservationEventType::Cancel) {
+                if (res.getSeatNumber() != event.seatNumber || !flight.cancelSeat(event.seatNumber)) return false;
+                res.cancel();
+                cancelledReservations++;
+            } else {
+                if (res.getSeatNumber() != event.previousSeat ||
+                    !flight.moveSeat(event.previousSeat, event.seatNumber)) {
+                    return false;
+                }
+                res.changeSeat(event.seatNumber);
+            }
+        }
+        syncSeats(event.flightNumber);
+        logEvent(event.type, event.flightNumber, event.seatNumber, event.previousSeat,
+                 event.reservationNumber, event.passengerId, event.fareCode, event.timestamp);
+        return true;
+    }
+
+    // One journal or saveEventLog line; false if it does not apply cleanly
+    bool replayLine(const string& line) {
+        if (line.empty()) return true;
+        if (line[0] == 'E') {
+            ReservationEvent event;
+            return ReservationLog::parseEvent(line, event) && replayEvent(event);
+        }
+        if (line[0] == 'F') {
+            // saveEventLog output names flights that must already be added
+            istringstream fields(line);
+            string tag, number;
+            int seats;
+            auto it = fields >> tag >> number >> seats ? flightIndex.find(number) : flightIndex.end();
+            return it != flightIndex.end() && flights[it->second].getTotalSeats() == seats;
+        }
+
+        vector<string> fields = splitFields(line);
+        if (fields[0] == "A" && fields.size() == 9) {
+            return addFlight(fields[1], fields[2], fields[3], fields[4], fields[5], fields[6],
+                             atof(fields[7].c_str()), atoi(fields[8].c_str()));
+        }
+        if (fields[0] == "P" && fields.size() == 6) {
+            return addPassenger(fields[1], fields[2], fields[3], fields[4], fields[5]);
+        }
+        if (fields[0] == "R" && fields.size() >= 5 && (fields.size() - 2) % 3 == 0) {
+            vector<FareClass> classes;
+            for (size_t f = 2; f < fields.size(); f += 3) {
+                classes.push_back({fields[f], atof(fields[f + 1].c_str()), atoi(fields[f + 2].c_str())});
+            }
+            return setFareClasses(fields[1], classes);
+        }
+        return false;
+    }
+
+    vector<const Reservation*> activeReservations(
+            const unordered_map<string, vector<size_t>>& index, const string& key) const {
+        vector<const Reservation*> result;
+        auto it = index.find(key);
+        if (it == index.end()) return result;
+        for (size_t pos : it->second) {
+            if (!reservations[pos].isCancelled()) result.push_back(&reservations[pos]);
+        }
+        return result;
+    }
+
 public:
-    AirlineReservationSystem() : lastReservationNumber(1000) {}
+    AirlineReservationSystem() : lastReservationNumber(1000), cancelledReservations(0) {}
+
+    // Adds a flight without prompting; returns false for duplicates or bad date/time
+    bool addFlight(const string& number, const string& origin, const string& destination,
+                   const string& date, const string& depTime, const string& arrTime,
+                   double price, int seats) {
+        int day = parseDayNumber(date);
+        int depMinutes = parseMinutes(depTime);
+        int arrMinutes = parseMinutes(arrTime);
+        if (flightIndex.find(number) != flightIndex.end() || day < 0 ||
+            depMinutes < 0 || arrMinutes < 0 || seats <= 0) {
+            return false;
+        }
+
+        flights.emplace_back(number, origin, destination, date, depTime, arrTime, price, seats);
+        flightIndex[number] = flights.size() - 1;
+        eventLog.trackFlight(number, seats);
+        routes.addFlight(flights.size() - 1, origin, destination, day, depMinutes, arrMinutes, price);
+        flightsByDay[day].push_back(flights.size() - 1);
+        schedule.add(flights.size() - 1, routes.findAirport(origin), routes.findAirport(destination),
+                     day, depMinutes, price, seats);
+        if (journal.is_open()) {
+            ostringstream line;
+            line << setprecision(17) << "A\t" << number << "\t" << origin << "\t" << destination << "\t"
+                 << date << "\t" << depTime << "\t" << arrTime << "\t" << price << "\t" << seats;
+            journalLine(line.str());
+        }
+        return true;
+    }
 
     void addFlight() {
         string number, origin, destination, date, depTime, arrTime;
@@ -195,11 +1178,25 @@ public:
         cout << "Total Seats: ";
         cin >> seats;
 
-        flights.emplace_back(number, origin, destination, date, depTime, arrTime, price, seats);
-        flightIndex[number] = flights.size() - 1;
+        if (!addFlight(number, origin, destination, date, depTime, arrTime, price, seats)) {
+            cout << "Error: Invalid date, time or seat count!" << endl;
+            return;
+        }
         cout << "\nFlight added successfully!" << endl;
     }
 
+    // Adds a passenger without prompting; returns false if the ID is taken
+    bool addPassenger(const string& id, const string& name, const string& phone,
+                      const string& email, const string& passport) {
+        if (passengerIndex.find(id) != passengerIndex.end()) {
+            return false;
+        }
+        passengers.emplace_back(id, name, phone, email, passport);
+        passengerIndex[id] = passengers.size() - 1;
+        journalLine("P\t" + id + "\t" + name + "\t" + phone + "\t" + email + "\t" + passport);
+        return true;
+    }
+
     void addPassenger() {
         string id, name, phone, email, passport;
 
@@ -222,11 +1219,61 @@ public:
         cout << "Passport Number: ";
         getline(cin, passport);
 
-        passengers.emplace_back(id, name, phone, email, passport);
-        passengerIndex[id] = passengers.size() - 1;
+        addPassenger(id, name, phone, email, passport);
         cout << "\nPassenger added successfully!" << endl;
     }
 
+    // Books a seat without prompting (seat 0 takes the first free one) in the
+    // given fare class, or the cheapest open class if none is given;
+    // returns the reservation number or "" on failure
+    string makeReservation(const string& flightNumber, const string& passengerId, int seatNumber,
+                           const string& fareCode = "") {
+        auto flightIt = flightIndex.find(flightNumber);
+        if (flightIt == flightIndex.end() || passengerIndex.find(passengerId) == passengerIndex.end()) {
+            return "";
+        }
+        Flight& flight = flights[flightIt->second];
+        int fareClass = fareCode.empty() ? flight.cheapestOpenFareClass() : flight.findFareClass(fareCode);
+        if (fareClass < 0) {
+            return "";
+        }
+        if (seatNumber == 0) {
+            seatNumber = flight.assignAnySeat(passengerId, 0, fareClass);
+            if (seatNumber == 0) return "";
+        } else if (!flight.assignSeat(seatNumber, passengerId, fareClass)) {
+            return "";
+        }
+
+        string reservationNumber = generateReservationNumber();
+        const string& code = flight.getFareClasses()[fareClass].code;
+        const ReservationEvent& event = logEvent(ReservationEventType::Book, flightNumber,
+                                                 seatNumber, 0, reservationNumber, passengerId, code);
+        reservations.emplace_back(reservationNumber, passengerId, flightNumber, seatNumber, code,
+                                  event.timestamp);
+        reservations.back().confirm();
+        indexReservation(reservations.size() - 1);
+        syncSeats(flightNumber);
+        return reservationNumber;
+    }
+
+    // Moves a live reservation to another free seat on the same flight
+    bool changeSeat(const string& reservationNumber, int newSeat) {
+        auto it = reservationIndex.find(reservationNumber);
+        if (it == reservationIndex.end() || reservations[it->second].isCancelled()) {
+            return false;
+        }
+        Reservation& res = reservations[it->second];
+        Flight& flight = flights[flightIndex.at(res.getFlightNumber())];
+        int oldSeat = res.getSeatNumber();
+        if (!flight.moveSeat(oldSeat, newSeat)) {
+            return false;
+        }
+        res.changeSeat(newSeat);
+        logEvent(ReservationEventType::ChangeSeat, res.getFlightNumber(), newSeat, oldSeat,
+                 reservationNumber, res.getPassengerId(), res.getFareCode());
+        return true;
+    }
+
     void makeReservation() {
         string flightNumber, passengerId;
         int seatNumber;
@@ -254,43 +1301,253 @@ public:
             return;
         }
 
+        string fareCode;
+        if (flight.getFareClasses().size() > 1) {
+            const vector<FareClass>& classes = flight.getFareClasses();
+            cout << "\nFare Classes:" << endl;
+            for (size_t c = 0; c < classes.size(); c++) {
+                cout << classes[c].code << ": ETB " << fixed << setprecision(2) << classes[c].price
+                     << " (" << flight.getFareAvailability(c) << " available)" << endl;
+            }
+            cout << "Enter Fare Class: ";
+            cin >> fareCode;
+
+            int fareClass = flight.findFareClass(fareCode);
+            if (fareClass < 0 || flight.getFareAvailability(fareClass) == 0) {
+                cout << "Error: Fare class not found or sold out!" << endl;
+                return;
+            }
+        }
+
         flight.displaySeatMap();
         cout << "\nEnter Seat Number: ";
         cin >> seatNumber;
 
-        if (!flight.assignSeat(seatNumber, passengerId)) {
+        string reservationNumber = makeReservation(flightNumber, passengerId, seatNumber, fareCode);
+        if (reservationNumber.empty()) {
             cout << "Error: Invalid seat number or seat already occupied!" << endl;
             return;
         }
 
-        string reservationNumber = generateReservationNumber();
-        reservations.emplace_back(reservationNumber, passengerId, flightNumber, seatNumber);
-        reservations.back().confirm();
-
         cout << "\nReservation successful!" << endl;
         cout << "Reservation Number: " << reservationNumber << endl;
     }
 
+    bool setFareClasses(const string& flightNumber, const vector<FareClass>& classes) {
+        auto it = flightIndex.find(flightNumber);
+        if (it == flightIndex.end() || !flights[it->second].setFareClasses(classes)) return false;
+        if (journal.is_open()) {
+            ostringstream line;
+            line << setprecision(17) << "R\t" << flightNumber;
+            for (const FareClass& fare : classes) {
+                line << "\t" << fare.code << "\t" << fare.price << "\t" << fare.bookingLimit;
+            }
+            journalLine(line.str());
+        }
+        return true;
+    }
+
+    void configureFareClasses() {
+        string flightNumber;
+        int count;
+        cout << "\nEnter Flight Number: ";
+        cin >> flightNumber;
+        if (flightIndex.find(flightNumber) == flightIndex.end()) {
+            cout << "Error: Flight not found!" << endl;
+            return;
+        }
+
+        cout << "Number of Fare Classes (most expensive first): ";
+        cin >> count;
+        vector<FareClass> classes;
+        for (int c = 0; c < count; c++) {
+            FareClass fare;
+            cout << "\nClass " << c + 1 << " Code: ";
+            cin >> fare.code;
+            cout << "Price (ETB): ";
+            cin >> fare.price;
+            cout << "Booking Limit (this class and cheaper ones): ";
+            cin >> fare.bookingLimit;
+            classes.push_back(fare);
+        }
+
+        if (!setFareClasses(flightNumber, classes)) {
+            cout << "Error: Seats already sold or booking limits not decreasing!" << endl;
+            return;
+        }
+        cout << "\nFare classes updated successfully!" << endl;
+    }
+
+    // Flights that can still sell a seat in the given fare class, from the caches only
+    vector<int> findFlightsWithFare(const string& fareCode, int minSeats) const {
+        vector<int> result;
+        for (size_t i = 0; i < flights.size(); i++) {
+            int fareClass = flights[i].findFareClass(fareCode);
+            if (fareClass >= 0 && flights[i].getFareAvailability(fareClass) >= minSeats) {
+                result.push_back(i);
+            }
+        }
+        return result;
+    }
+
+    // Same query recomputed from every seat map, kept for benchmarking
+    vector<int> recountFlightsWithFare(const string& fareCode, int minSeats) const {
+        vector<int> result;
+        for (size_t i = 0; i < flights.size(); i++) {
+            int fareClass = flights[i].findFareClass(fareCode);
+            if (fareClass >= 0 && flights[i].recountFareAvailability(fareClass) >= minSeats) {
+                result.push_back(i);
+            }
+        }
+        return result;
+    }
+
+    const Reservation* findReservation(const string& reservationNumber) const {
+        auto it = reservationIndex.find(reservationNumber);
+        return it == reservationIndex.end() ? nullptr : &reservations[it->second];
+    }
+
+    vector<const Reservation*> getPassengerReservations(const string& passengerId) const {
+        return activeReservations(reservationsByPassenger, passengerId);
+    }
+
+    vector<const Reservation*> getFlightReservations(const string& flightNumber) const {
+        return activeReservations(reservationsByFlight, flightNumber);
+    }
+
+    // Cancels without prompting; returns false if unknown or already cancelled
+    bool cancelReservation(const string& reservationNumber) {
+        auto it = reservationIndex.find(reservationNumber);
+        if (it == reservationIndex.end() || reservations[it->second].isCancelled()) {
+            return false;
+        }
+
+        Reservation& res = reservations[it->second];
+        auto flightIt = flightIndex.find(res.getFlightNumber());
+        if (flightIt != flightIndex.end()) {
+            flights[flightIt->second].cancelSeat(res.getSeatNumber());
+            syncSeats(res.getFlightNumber());
+        }
+        res.cancel();
+        logEvent(ReservationEventType::Cancel, res.getFlightNumber(), res.getSeatNumber(), 0,
+                 res.getReservationNumber(), res.getPassengerId(), res.getFareCode());
+
+        // Compact once tombstones make up half the store, so the cost is amortized O(1)
+        if (++cancelledReservations >= COMPACTION_MIN_TOMBSTONES &&
+            cancelledReservations * 2 >= reservations.size()) {
+            compactReservations();
+        }
+        return true;
+    }
+
     void cancelReservation() {
         string reservationNumber;
         cout << "\nEnter Reservation Number: ";
         cin >> reservationNumber;
 
-        auto it = find_if(reservations.begin(), reservations.end(),
-            [&](const Reservation& res) { return res.getReservationNumber() == reservationNumber; });
-
-        if (it == reservations.end()) {
+        const Reservation* res = findReservation(reservationNumber);
+        if (res == nullptr) {
             cout << "Error: Reservation not found!" << endl;
             return;
         }
+        if (!cancelReservation(reservationNumber)) {
+            cout << "Error: Reservation is already cancelled!" << endl;
+            return;
+        }
+        cout << "\nReservation cancelled successfully!" << endl;
+    }
 
-        auto flightIt = flightIndex.find(it->getFlightNumber());
-        if (flightIt != flightIndex.end()) {
-            flights[flightIt->second].cancelSeat(it->getSeatNumber());
+    // Drops cancelled reservations and rebuilds the indexes over the survivors
+    void compactReservations() {
+        reservations.erase(remove_if(reservations.begin(), reservations.end(),
+            [](const Reservation& res) { return res.isCancelled(); }), reservations.end());
+        reservationIndex.clear();
+        reservationsByPassenger.clear();
+        reservationsByFlight.clear();
+        for (size_t pos = 0; pos < reservations.size(); pos++) {
+            indexReservation(pos);
         }
+        cancelledReservations = 0;
+    }
 
-        it->cancel();
-        cout << "\nReservation cancelled successfully!" << endl;
+    size_t getReservationCount() const { return reservations.size(); }
+
+    size_t getEventCount() const { return eventLog.size(); }
+    void saveEventLog(ostream& out) const { eventLog.writeTo(out); }
+
+    // Rebuilds reservations and seat maps from saveEventLog output or a journal
+    // after a restart; no bookings may have been made yet. Flights named by a
+    // saved log must already be added again. Stops at the first line that does
+    // not replay cleanly and leaves its 1-based number in lineNumber.
+    bool recoverFromLog(istream& in, size_t& lineNumber) {
+        lineNumber = 0;
+        if (!reservations.empty()) return false;
+        string line;
+        while (getline(in, line)) {
+            lineNumber++;
+            if (!replayLine(line)) return false;
+        }
+        return true;
+    }
+
+    // Replays the journal at path, if there is one, then appends every later
+    // change to it. lineNumber is the failing line, or 0 if the file would not open.
+    bool openJournal(const string& path, size_t& lineNumber) {
+        ifstream in(path);
+        lineNumber = 0;
+        if (in && !recoverFromLog(in, lineNumber)) return false;
+        lineNumber = 0;
+        journal.open(path, ios::app);
+        return journal.is_open();
+    }
+
+    vector<bool> seatMapAt(const string& flightNumber, time_t when) const {
+        return eventLog.seatMapAt(flightNumber, when);
+    }
+
+    void displaySeatMapHistory() const {
+        string flightNumber, date, clock;
+        cout << "\nEnter Flight Number: ";
+        cin >> flightNumber;
+        cout << "Enter Date (DD/MM/YYYY): ";
+        cin >> date;
+        cout << "Enter Time (HH:MM): ";
+        cin >> clock;
+
+        tm moment = {};
+        int minutes = parseMinutes(clock);
+        if (findFlight(flightNumber) == nullptr || parseDayNumber(date) < 0 || minutes < 0 ||
+            sscanf(date.c_str(), "%d/%d/%d", &moment.tm_mday, &moment.tm_mon, &moment.tm_year) != 3) {
+            cout << "Error: Unknown flight or invalid date/time!" << endl;
+            return;
+        }
+        moment.tm_mon -= 1;
+        moment.tm_year -= 1900;
+        moment.tm_hour = minutes / 60;
+        moment.tm_min = minutes % 60;
+        moment.tm_isdst = -1;
+
+        vector<bool> occupied = seatMapAt(flightNumber, mktime(&moment));
+        int taken = count(occupied.begin(), occupied.end(), true);
+        cout << "\nSeat Map for Flight " << flightNumber << " at " << date << " " << clock << ":" << endl;
+        cout << "Available Seats: " << occupied.size() - taken << "/" << occupied.size() << endl;
+        for (size_t i = 0; i < occupied.size(); i++) {
+            if (i % 6 == 0) {
+                cout << "\nRow " << (i / 6 + 1) << ": ";
+            }
+            cout << (occupied[i] ? "X" : "O") << " ";
+        }
+        cout << "\nX = Occupied, O = Available" << endl;
+    }
+
+    const Passenger* findPassenger(const string& passengerId) const {
+        auto it = passengerIndex.find(passengerId);
+        return it == passengerIndex.end() ? nullptr : &passengers[it->second];
+    }
+
+    const Flight* findFlight(const string& flightNumber) const {
+        auto it = flightIndex.find(flightNumber);
+        return it == flightIndex.end() ? nullptr : &flights[it->second];
     }
 
     void displayFlights() const {
@@ -307,6 +1564,7 @@ public:
 
     void searchFlights() {
         string origin, destination, date;
+        int rankChoice;
         cin.ignore();
         cout << "\nEnter Origin: ";
         getline(cin, origin);
@@ -314,31 +1572,173 @@ public:
         getline(cin, destination);
         cout << "Enter Date (DD/MM/YYYY): ";
         getline(cin, date);
+        cout << "Rank connections by (1) Arrival Time (2) Price: ";
+        cin >> rankChoice;
 
-        bool found = false;
-        for (const auto& flight : flights) {
-            if (flight.getOrigin() == origin && 
-                flight.getDestination() == destination && 
-                flight.getDepartureDate() == date) {
-                flight.displayInfo();
-                found = true;
-            }
+        int day = parseDayNumber(date);
+        vector<int> direct = routes.directFlights(origin, destination, day);
+        for (int idx : direct) {
+            flights[idx].displayInfo();
+        }
+
+        vector<Itinerary> itineraries = routes.findItineraries(origin, destination, day,
+            MAX_CONNECTIONS, MIN_LAYOVER_MINUTES, MAX_LAYOVER_MINUTES, rankChoice == 2, 10, true);
+        if (!itineraries.empty()) cout << "\n=== Connecting Itineraries ===" << endl;
+        for (const auto& itinerary : itineraries) {
+            displayItinerary(itinerary);
         }
 
-        if (!found) {
+        if (direct.empty() && itineraries.empty()) {
             cout << "\nNo flights found for the specified route and date." << endl;
         }
     }
 
+    void displayItinerary(const Itinerary& itinerary) const {
+        cout << "\n" << itinerary.flights.size() - 1 << " stop(s), departs "
+             << formatMinutes(itinerary.departure % MINUTES_PER_DAY) << ", arrives "
+             << formatMinutes(itinerary.arrival % MINUTES_PER_DAY);
+        int extraDays = itinerary.arrival / MINUTES_PER_DAY - itinerary.departure / MINUTES_PER_DAY;
+        if (extraDays > 0) cout << " (+" << extraDays << " day)";
+        cout << ", total ETB " << fixed << setprecision(2) << itinerary.totalPrice << endl;
+        for (int idx : itinerary.flights) {
+            const Flight& flight = flights[idx];
+            cout << "  " << flight.getFlightNumber() << " " << flight.getOrigin() << " -> "
+                 << flight.getDestination() << " " << flight.getDepartureDate() << " "
+                 << flight.getDepartureTime() << "-" << flight.getArrivalTime() << endl;
+        }
+    }
+
+    vector<int> findDirectFlights(const string& origin, const string& destination,
+                                  const string& date) const {
+        return routes.directFlights(origin, destination, parseDayNumber(date));
+    }
+
+    vector<Itinerary> findItineraries(const string& origin, const string& destination,
+                                      const string& date, bool rankByPrice, size_t limit) {
+        return routes.findItineraries(origin, destination, parseDayNumber(date), MAX_CONNECTIONS,
+                                      MIN_LAYOVER_MINUTES, MAX_LAYOVER_MINUTES, rankByPrice, limit);
+    }
+
+    vector<int> findFlexibleFlights(const string& origin, const string& destination,
+                                    const string& date, int flexDays, double maxPrice,
+                                    int minSeats = 1) {
+        int from = routes.findAirport(origin), to = routes.findAirport(destination);
+        int day = parseDayNumber(date);
+        if (from < 0 || to < 0 || day < 0 || flexDays < 0) return {};
+        return schedule.search(from, to, day, flexDays, maxPrice, minSeats);
+    }
+
+    void searchFlexibleDates() {
+        string origin, destination, date;
+        int flexDays;
+        double maxPrice;
+        cin.ignore();
+        cout << "\nEnter Origin: ";
+        getline(cin, origin);
+        cout << "Enter Destination: ";
+        getline(cin, destination);
+        cout << "Enter Date (DD/MM/YYYY): ";
+        getline(cin, date);
+        cout << "Days Before/After: ";
+        cin >> flexDays;
+        if (flexDays < 0) {
+            cout << "Error: Days Before/After cannot be negative!" << endl;
+            return;
+        }
+        cout << "Maximum Price (ETB): ";
+        cin >> maxPrice;
+
+        vector<int> matches = findFlexibleFlights(origin, destination, date, flexDays, maxPrice);
+        if (matches.empty()) {
+            cout << "\nNo flights found within the date range and price." << endl;
+            return;
+        }
+        cout << "\n=== Cheapest Flights ===" << endl;
+        for (size_t i = 0; i < matches.size() && i < 10; i++) {
+            flights[matches[i]].displayInfo();
+        }
+    }
+
+    // Boarding manifest: flight details, seat map and the passenger in every taken seat
+    void renderManifest(const Flight& flight, string& out) const {
+        out += "\n==== BOARDING MANIFEST ====\n";
+        flight.renderInfo(out);
+        flight.renderSeatMap(out);
+        out += "Passengers:\n";
+        for (int seat = 1; seat <= flight.getTotalSeats(); seat++) {
+            if (flight.isSeatAvailable(seat)) continue;
+            string passengerId = flight.getSeatPassenger(seat);
+            const Passenger* passenger = findPassenger(passengerId);
+            out += "  Seat ";
+            appendNumber(out, seat);
+            out += "  ";
+            out += passengerId;
+            out += "  ";
+            out += passenger == nullptr ? "(unknown)" : passenger->getName();
+            out += '\n';
+        }
+    }
+
+    // Renders every flight departing on date into one pre-sized buffer and writes
+    // it with a single call; returns the number of flights written, -1 on error
+    int exportManifests(const string& date, const string& path) const {
+        auto it = flightsByDay.find(parseDayNumber(date));
+        const vector<int> none;
+        const vector<int>& dayFlights = it == flightsByDay.end() ? none : it->second;
+
+        size_t capacity = 0;
+        for (int idx : dayFlights) capacity += flights[idx].renderSizeHint();
+        string buffer;
+        buffer.reserve(capacity);
+        for (int idx : dayFlights) renderManifest(flights[idx], buffer);
+
+        FILE* file = fopen(path.c_str(), "wb");
+        if (file == nullptr) return -1;
+        size_t written = fwrite(buffer.data(), 1, buffer.size(), file);
+        fclose(file);
+        return written == buffer.size() ? int(dayFlights.size()) : -1;
+    }
+
+    void exportDayManifests() const {
+        string date;
+        cout << "\nEnter Date (DD/MM/YYYY): ";
+        cin >> date;
+        if (parseDayNumber(date) < 0) {
+            cout << "Error: Invalid date!" << endl;
+            return;
+        }
+
+        string padded = formatDayNumber(parseDayNumber(date));   // DD/MM/YYYY even if typed as 1/3/2026
+        string path = "manifests_" + padded.substr(6) + padded.substr(3, 2) + padded.substr(0, 2) + ".txt";
+        int written = exportManifests(date, path);
+        if (written < 0) {
+            cout << "Error: Could not write " << path << "!" << endl;
+            return;
+        }
+        cout << "\n" << written << " manifest(s) written to " << path << endl;
+    }
+
+    // Direct search the way it was done before the route index, kept for benchmarking
+    int scanDirectFlights(const string& origin, const string& destination,
+                          const string& date) const {
+        int count = 0;
+        for (const auto& flight : flights) {
+            if (flight.getOrigin() == origin &&
+                flight.getDestination() == destination &&
+                flight.getDepartureDate() == date) {
+                count++;
+            }
+        }
+        return count;
+    }
+
     void displayReservation() {
         string reservationNumber;
         cout << "\nEnter Reservation Number: ";
         cin >> reservationNumber;
 
-        auto it = find_if(reservations.begin(), reservations.end(),
-            [&](const Reservation& res) { return res.getReservationNumber() == reservationNumber; });
-
-        if (it == reservations.end()) {
+        const Reservation* it = findReservation(reservationNumber);
+        if (it == nullptr) {
             cout << "Error: Reservation not found!" << endl;
             return;
         }
@@ -357,12 +1757,708 @@ public:
     }
 };
 
+double percentile(vector<double> samples, double fraction) {
+    if (samples.empty()) return 0;
+    size_t k = min(samples.size() - 1, size_t(fraction * samples.size()));
+    nth_element(samples.begin(), samples.begin() + k, samples.end());
+    return samples[k];
+}
+
+void printLatency(const string& label, const vector<double>& micros) {
+    double total = 0;
+    for (double value : micros) total += value;
+    cout << left << setw(28) << label << right << fixed << setprecision(2)
+         << " avg " << setw(9) << total / max<size_t>(1, micros.size()) << " us"
+         << "  p50 " << setw(9) << percentile(micros, 0.50) << " us"
+         << "  p95 " << setw(9) << percentile(micros, 0.95) << " us"
+         << "  p99 " << setw(9) << percentile(micros, 0.99) << " us" << endl;
+}
+
+string airportCode(int id) {
+    string code = "AAA";
+    code[0] += id / 676;
+    code[1] += (id / 26) % 26;
+    code[2] += id % 26;
+    return code;
+}
+
+string formatDate(int dayOfMonth, int month, int year) {
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "%02d/%02d/%04d", dayOfMonth, month, year);
+    return buffer;
+}
+
+void runRouteSearchBenchmark() {
+    const int flightCount = 100000;
+    const int airportCount = 150;
+    const int days = 28;
+    const int queries = 2000;
+
+    AirlineReservationSystem system;
+    mt19937 rng(42);
+    uniform_int_distribution<int> airport(0, airportCount - 1);
+    uniform_int_distribution<int> day(1, days);
+    uniform_int_distribution<int> minute(0, MINUTES_PER_DAY - 1);
+    uniform_int_distribution<int> duration(60, 6 * 60);
+    uniform_real_distribution<double> fare(2000, 20000);
+
+    cout << "\nBuilding schedule of " << flightCount << " flights..." << endl;
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < flightCount; i++) {
+        int from = airport(rng), to = airport(rng);
+        if (to == from) to = (to + 1) % airportCount;
+        int dep = minute(rng);
+        int arr = (dep + duration(rng)) % MINUTES_PER_DAY;
+        system.addFlight("BM" + to_string(i), airportCode(from), airportCode(to),
+                         formatDate(day(rng), 2, 2026), formatMinutes(dep), formatMinutes(arr),
+                         fare(rng), 180);
+    }
+    double buildMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout << "Schedule built in " << fixed << setprecision(1) << buildMs << " ms" << endl;
+
+    vector<double> scanTimes, directTimes, connectionTimes;
+    size_t directFound = 0, itinerariesFound = 0;
+    for (int q = 0; q < queries; q++) {
+        string from = airportCode(airport(rng)), to = airportCode(airport(rng));
+        string date = formatDate(day(rng), 2, 2026);
+
+        auto t0 = chrono::steady_clock::now();
+        int scanned = system.scanDirectFlights(from, to, date);
+        auto t1 = chrono::steady_clock::now();
+        vector<int> direct = system.findDirectFlights(from, to, date);
+        auto t2 = chrono::steady_clock::now();
+        vector<Itinerary> itineraries = system.findItineraries(from, to, date, q % 2 == 1, 10);
+        auto t3 = chrono::steady_clock::now();
+
+        if (scanned != int(direct.size())) {
+            cout << "Mismatch between index and scan for " << from << " -> " << to << endl;
+        }
+        directFound += direct.size();
+        itinerariesFound += itineraries.size();
+        scanTimes.push_back(chrono::duration<double, micro>(t1 - t0).count());
+        directTimes.push_back(chrono::duration<double, micro>(t2 - t1).count());
+        connectionTimes.push_back(chrono::duration<double, micro>(t3 - t2).count());
+    }
+
+    cout << "\n" << queries << " random queries (" << directFound << " direct flights, "
+         << itinerariesFound << " itineraries returned)" << endl;
+    printLatency("Direct search (full scan)", scanTimes);
+    printLatency("Direct search (route index)", directTimes);
+    printLatency("Connections (up to 2 stops)", connectionTimes);
+}
+
+int benchmarkThreadCount() {
+    return max(4u, thread::hardware_concurrency());
+}
+
+void runSeatBookingStressTest() {
+    const int seats = 600;
+    const int agents = 4000;
+    const int rounds = 10;
+    const int threadCount = benchmarkThreadCount();
+
+    cout << "\n" << agents << " agents on " << threadCount << " threads booking a "
+         << seats << "-seat flight, " << rounds << " rounds" << endl;
+
+    long long sold = 0, cancelled = 0, turnedAway = 0, doubleSold = 0, mismatches = 0;
+    for (int round = 0; round < rounds; round++) {
+        Flight hot("HOT" + to_string(round), "ADD", "NBO", "01/03/2026", "08:00", "10:00", 5000, seats);
+        unique_ptr<atomic<int>[]> holders(new atomic<int>[seats]);
+        for (int i = 0; i < seats; i++) holders[i].store(0);
+        atomic<long long> roundSold(0), roundCancelled(0), roundTurnedAway(0), roundDoubleSold(0);
+
+        vector<thread> workers;
+        for (int t = 0; t < threadCount; t++) {
+            workers.emplace_back([&, t]() {
+                mt19937 rng(round * 1000 + t);
+                uniform_int_distribution<int> seat(1, seats);
+                for (int agent = t; agent < agents; agent += threadCount) {
+                    string passengerId = "P" + to_string(agent);
+                    int seatNumber = seat(rng);
+                    if (!hot.assignSeat(seatNumber, passengerId)) {
+                        seatNumber = hot.assignAnySeat(passengerId, agent * 7);
+                    }
+                    if (seatNumber == 0) {
+                        roundTurnedAway++;
+                        continue;
+                    }
+                    roundSold++;
+                    if (holders[seatNumber - 1].fetch_add(1) != 0) roundDoubleSold++;
+                    if (rng() % 4 == 0) {
+                        holders[seatNumber - 1].fetch_sub(1);
+                        hot.cancelSeat(seatNumber);
+                        roundCancelled++;
+                    }
+                }
+            });
+        }
+        for (auto& worker : workers) worker.join();
+
+        int held = 0;
+        for (int i = 0; i < seats; i++) {
+            int h = holders[i].load();
+            held += h;
+            bool occupied = !hot.isSeatAvailable(i + 1);
+            if (h > 1 || occupied != (h == 1) || occupied == hot.getSeatPassenger(i + 1).empty()) {
+                mismatches++;
+            }
+        }
+        if (held != seats - hot.getAvailableSeats()) mismatches++;
+
+        sold += roundSold;
+        cancelled += roundCancelled;
+        turnedAway += roundTurnedAway;
+        doubleSold += roundDoubleSold;
+    }
+
+    cout << "Seats sold: " << sold << ", cancelled: " << cancelled
+         << ", turned away: " << turnedAway << endl;
+    cout << "Double-sold seats: " << doubleSold << ", seat map mismatches: " << mismatches << endl;
+    cout << (doubleSold == 0 && mismatches == 0 ? "PASS" : "FAIL") << endl;
+}
+
+void runSeatBookingThroughputBenchmark() {
+    const int seats = 200000;
+    const int threadCount = benchmarkThreadCount();
+
+    Flight hot("HOT", "ADD", "NBO", "01/03/2026", "08:00", "10:00", 5000, seats);
+    auto start = chrono::steady_clock::now();
+    vector<thread> workers;
+    for (int t = 0; t < threadCount; t++) {
+        workers.emplace_back([&, t]() {
+            string passengerId = "T" + to_string(t);
+            int hint = t * (seats / threadCount);
+            while ((hint = hot.assignAnySeat(passengerId, hint)) != 0) {}
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    double lockFreeSec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // Same workload behind a single lock, as a booking desk with a global mutex would do it
+    vector<bool> seatMap(seats, false);
+    vector<string> seatAssignments(seats);
+    mutex bookingLock;
+    int nextFree = 0;
+    start = chrono::steady_clock::now();
+    workers.clear();
+    for (int t = 0; t < threadCount; t++) {
+        workers.emplace_back([&, t]() {
+            string passengerId = "T" + to_string(t);
+            while (true) {
+                lock_guard<mutex> guard(bookingLock);
+                while (nextFree < seats && seatMap[nextFree]) nextFree++;
+                if (nextFree == seats) break;
+                seatMap[nextFree] = true;
+                seatAssignments[nextFree] = passengerId;
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    double lockedSec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "\nBooking " << seats << " seats with " << threadCount << " threads" << endl;
+    cout << fixed << setprecision(0);
+    cout << "Atomic seat claims: " << seats / lockFreeSec << " bookings/sec (sold "
+         << seats - hot.getAvailableSeats() << ")" << endl;
+    cout << "Global mutex:       " << seats / lockedSec << " bookings/sec" << endl;
+}
+
+// Samples ranks 0..n-1 with probability proportional to 1 / (rank + 1)^exponent
+class ZipfSampler {
+private:
+    vector<double> cdf;
+
+public:
+    ZipfSampler(int n, double exponent) : cdf(n) {
+        double sum = 0;
+        for (int i = 0; i < n; i++) {
+            sum += 1.0 / pow(i + 1, exponent);
+            cdf[i] = sum;
+        }
+        for (double& value : cdf) value /= sum;
+    }
+
+    int operator()(mt19937_64& rng) const {
+        double u = uniform_real_distribution<double>(0, 1)(rng);
+        int rank = lower_bound(cdf.begin(), cdf.end(), u) - cdf.begin();
+        return min(rank, int(cdf.size()) - 1);
+    }
+};
+
+struct BookingStormConfig {
+    uint64_t seed = 2026;
+    int flights = 200;
+    int seatsPerFlight = 300;
+    int passengers = 100000;
+    double zipfExponent = 1.1;
+    double cancelRate = 0.10;       // share of bookings later cancelled
+    double seatChoiceRate = 0.70;   // share of passengers who pick a seat themselves
+};
+
+// Drives AirlineReservationSystem directly, without the cin prompts, as if a
+// sale had just opened. The same seed always produces the same operation stream.
+class BookingStormGenerator {
+private:
+    BookingStormConfig config;
+
+    static string flightNumberFor(int rank) { return "ET" + to_string(500 + rank); }
+
+public:
+    explicit BookingStormGenerator(const BookingStormConfig& cfg) : config(cfg) {}
+
+    void run(AirlineReservationSystem& system) const {
+        mt19937_64 rng(config.seed);
+        ZipfSampler popularity(config.flights, config.zipfExponent);
+        uniform_int_distribution<int> seat(1, config.seatsPerFlight);
+        uniform_real_distribution<double> chance(0, 1);
+
+        for (int f = 0; f < config.flights; f++) {
+            system.addFlight(flightNumberFor(f), "ADD", airportCode(f % 100), "01/03/2026",
+                             "08:00", "11:00", 4000 + f * 10, config.seatsPerFlight);
+        }
+
+        vector<double> bookLatency, cancelLatency;
+        bookLatency.reserve(config.passengers);
+        vector<string> toCancel;
+        long long booked = 0, rejected = 0, cancelled = 0;
+        uint64_t digest = 1469598103934665603ULL;
+
+        auto start = chrono::steady_clock::now();
+        for (int p = 0; p < config.passengers; p++) {
+            string passengerId = "SP" + to_string(p);
+            system.addPassenger(passengerId, "Passenger " + to_string(p), "0900000000",
+                                passengerId + "@mail.et", "EP" + to_string(p));
+
+            string flightNumber = flightNumberFor(popularity(rng));
+            int preferredSeat = chance(rng) < config.seatChoiceRate ? seat(rng) : 0;
+
+            auto t0 = chrono::steady_clock::now();
+            string reservationNumber = system.makeReservation(flightNumber, passengerId, preferredSeat);
+            if (reservationNumber.empty() && preferredSeat != 0) {
+                reservationNumber = system.makeReservation(flightNumber, passengerId, 0);
+            }
+            auto t1 = chrono::steady_clock::now();
+            bookLatency.push_back(chrono::duration<double, micro>(t1 - t0).count());
+
+            if (reservationNumber.empty()) {
+                rejected++;
+            } else {
+                booked++;
+                if (chance(rng) < config.cancelRate) toCancel.push_back(reservationNumber);
+            }
+            for (char c : reservationNumber + flightNumber) digest = (digest ^ c) * 1099511628211ULL;
+
+            // Cancellations trickle in while the sale is still running
+            if (toCancel.size() >= 64) {
+                for (const string& number : toCancel) {
+                    auto c0 = chrono::steady_clock::now();
+                    if (system.cancelReservation(number)) cancelled++;
+                    cancelLatency.push_back(chrono::duration<double, micro>(
+                        chrono::steady_clock::now() - c0).count());
+                }
+                toCancel.clear();
+            }
+        }
+        double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        // Seat-fill accuracy: every occupied seat must be backed by exactly one live reservation
+        long long seatsSold = 0, activeReservations = 0, mismatchedFlights = 0;
+        int soldOut = 0;
+        for (int f = 0; f < config.flights; f++) {
+            const Flight* flight = system.findFlight(flightNumberFor(f));
+            int sold = flight->getTotalSeats() - flight->getAvailableSeats();
+            int live = system.getFlightReservations(flightNumberFor(f)).size();
+            seatsSold += sold;
+            activeReservations += live;
+            if (sold != live) mismatchedFlights++;
+            if (flight->getAvailableSeats() == 0) soldOut++;
+        }
+
+        long long operations = booked + rejected + cancelled;
+        cout << "\nBooking storm: seed " << config.seed << ", " << config.passengers
+             << " passengers, " << config.flights << " flights x " << config.seatsPerFlight
+             << " seats, Zipf " << config.zipfExponent << endl;
+        cout << "Booked " << booked << ", rejected (sold out) " << rejected
+             << ", cancelled " << cancelled << endl;
+        cout << "Throughput: " << fixed << setprecision(0) << operations / elapsed
+             << " operations/sec over " << setprecision(3) << elapsed << " s" << endl;
+        printLatency("makeReservation", bookLatency);
+        printLatency("cancelReservation", cancelLatency);
+        cout << "Seats sold " << seatsSold << ", live reservations " << activeReservations
+             << ", flights sold out " << soldOut << "/" << config.flights
+             << ", mismatched flights " << mismatchedFlights << endl;
+        cout << "Seat-fill accuracy: " << (mismatchedFlights == 0 ? "PASS" : "FAIL")
+             << ", outcome digest " << hex << digest << dec << endl;
+    }
+};
+
+void runBookingStormBenchmark() {
+    BookingStormConfig config;
+    cout << "\nEnter seed: ";
+    cin >> config.seed;
+
+    AirlineReservationSystem system;
+    BookingStormGenerator(config).run(system);
+}
+
+void runReservationLogBenchmark() {
+    const int flightCount = 100;
+    const int seats = 300;
+    const int eventCount = 1000000;
+    const time_t saleStart = 1767225600;  // 01/01/2026 00:00 UTC
+
+    // Synthetic month of activity: valid book / cancel / change-seat events
+    mt19937 rng(7);
+    vector<vector<int>> holder(flightCount, vector<int>(seats + 1, 0));
+    vector<string> flightNumbers;
+    ReservationLog checkpointed(128), unCheckpointed(size_t(-1));
+    for (int f = 0; f < flightCount; f++) {
+        flightNumbers.push_back("ET" + to_string(500 + f));
+        checkpointed.trackFlight(flightNumbers[f], seats);
+        unCheckpointed.trackFlight(flightNumbers[f], seats);
+    }
+
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < eventCount; i++) {
+        int f = rng() % flightCount;
+        int seat = 1 + rng() % seats;
+        time_t when = saleStart + time_t(i) * 30 * 86400 / eventCount;
+        ReservationEventType type;
+        int previousSeat = 0;
+        if (holder[f][seat] == 0) {
+            type = ReservationEventType::Book;
+            holder[f][seat] = i + 1;
+        } else if (rng() % 3 == 0) {
+            int target = 1 + rng() % seats;
+            if (holder[f][target] != 0) continue;
+            type = ReservationEventType::ChangeSeat;
+            previousSeat = seat;
+            holder[f][target] = holder[f][seat];
+            holder[f][seat] = 0;
+            seat = target;
+        } else {
+            type = ReservationEventType::Cancel;
+            holder[f][seat] = 0;
+        }
+        checkpointed.append(type, flightNumbers[f], seat, previousSeat, "RES", "P", "Y", when);
+        unCheckpointed.append(type, flightNumbers[f], seat, previousSeat, "RES", "P", "Y", when);
+    }
+    double appendSec = chrono::duration<double>(chrono::steady_clock::now() - start).count() / 2;
+
+    cout << "\nReservation log: " << checkpointed.size() << " events over " << flightCount
+         << " flights, 30 days" << endl;
+    cout << "Append: " << fixed << setprecision(0) << checkpointed.size() / appendSec
+         << " events/sec" << endl;
+
+    // Point-in-time seat maps at random moments, with and without checkpoints
+    vector<double> tailTimes, fullTimes;
+    size_t mismatches = 0;
+    for (int q = 0; q < 1000; q++) {
+        int f = rng() % flightCount;
+        time_t when = saleStart + rng() % (30 * 86400);
+        auto t0 = chrono::steady_clock::now();
+        vector<bool> fromCheckpoint = checkpointed.seatMapAt(flightNumbers[f], when);
+        auto t1 = chrono::steady_clock::now();
+        vector<bool> fromScratch = unCheckpointed.seatMapAt(flightNumbers[f], when);
+        auto t2 = chrono::steady_clock::now();
+        if (fromCheckpoint != fromScratch) mismatches++;
+        tailTimes.push_back(chrono::duration<double, micro>(t1 - t0).count());
+        fullTimes.push_back(chrono::duration<double, micro>(t2 - t1).count());
+    }
+    printLatency("Seat map (checkpoint+tail)", tailTimes);
+    printLatency("Seat map (full replay)", fullTimes);
+    cout << "Point-in-time mismatches: " << mismatches << endl;
+
+    // Crash recovery: rebuild a whole system from its saved log
+    AirlineReservationSystem live, restarted;
+    for (int f = 0; f < flightCount; f++) {
+        live.addFlight(flightNumbers[f], "ADD", "NBO", "01/03/2026", "08:00", "10:00", 5000, seats);
+        restarted.addFlight(flightNumbers[f], "ADD", "NBO", "01/03/2026", "08:00", "10:00", 5000, seats);
+    }
+    vector<string> booked;
+    for (int p = 0; p < 20000; p++) {
+        string passengerId = "P" + to_string(p);
+        live.addPassenger(passengerId, "Passenger", "0900000000", "p@mail.et", "EP");
+        restarted.addPassenger(passengerId, "Passenger", "0900000000", "p@mail.et", "EP");
+        string number = live.makeReservation(flightNumbers[rng() % flightCount], passengerId, 0);
+        if (!number.empty()) booked.push_back(number);
+        if (!booked.empty() && rng() % 5 == 0) live.cancelReservation(booked[rng() % booked.size()]);
+    }
+    stringstream saved;
+    live.saveEventLog(saved);
+    size_t logEvents = live.getEventCount();
+
+    start = chrono::steady_clock::now();
+    size_t failedLine;
+    bool recovered = restarted.recoverFromLog(saved, failedLine);
+    double replaySec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    size_t seatDiffs = 0;
+    for (const string& number : flightNumbers) {
+        if (live.findFlight(number)->getAvailableSeats() != restarted.findFlight(number)->getAvailableSeats()) {
+            seatDiffs++;
+        }
+    }
+    cout << "Recovery replay: " << (recovered ? "OK" : "FAILED") << ", " << setprecision(0)
+         << logEvents / replaySec << " events/sec, flights with differing seat counts: "
+         << seatDiffs << endl;
+}
+
+void runFlexibleSearchBenchmark() {
+    const int airportCount = 100;
+    const int routeCount = 2000;
+    const int days = 500;
+    const int scanQueries = 20;
+    const int indexedQueries = 20000;
+    const int firstDay = parseDayNumber("01/01/2026");
+
+    // Flight-day rows are generated straight into both layouts; a million Flight
+    // objects with seat maps would not fit comfortably in memory.
+    struct FlightRecord {
+        string origin;
+        string destination;
+        string date;
+        double price;
+        int availableSeats;
+    };
+
+    mt19937 rng(11);
+    uniform_int_distribution<int> airport(0, airportCount - 1);
+    uniform_real_distribution<double> fare(3000, 20000);
+    vector<pair<int, int>> routePairs;
+    while (int(routePairs.size()) < routeCount) {
+        int from = airport(rng), to = airport(rng);
+        if (from != to) routePairs.push_back({from, to});
+    }
+
+    vector<FlightRecord> records;
+    records.reserve(routeCount * days);
+    ColumnarSchedule schedule;
+    schedule.reserve(routeCount * days);
+    for (int d = 0; d < days; d++) {
+        int dayNumber = firstDay + d;
+        string date = formatDayNumber(dayNumber);
+        for (int r = 0; r < routeCount; r++) {
+            double price = fare(rng);
+            int seatsLeft = rng() % 200;
+            schedule.add(records.size(), routePairs[r].first, routePairs[r].second,
+                         dayNumber, (r * 37) % MINUTES_PER_DAY, price, seatsLeft);
+            records.push_back({airportCode(routePairs[r].first), airportCode(routePairs[r].second),
+                               date, price, seatsLeft});
+        }
+    }
+    cout << "\nSchedule of " << records.size() << " flight-days ("
+         << routeCount << " routes x " << days << " days)" << endl;
+
+    auto query = [&](int q, int& route, int& dayOffset) {
+        route = (q * 7919) % routeCount;
+        dayOffset = 3 + (q * 104729) % (days - 6);
+    };
+
+    auto start = chrono::steady_clock::now();
+    schedule.search(0, 0, firstDay, 0, 0, 1);  // first query sorts the columns
+    cout << "Sorted columns in " << fixed << setprecision(1)
+         << chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() << " ms" << endl;
+
+    vector<double> scanTimes, indexedTimes;
+    size_t mismatches = 0;
+    for (int q = 0; q < indexedQueries; q++) {
+        int route, dayOffset;
+        query(q, route, dayOffset);
+        const int flexDays = 3;
+        const double maxPrice = 8000;
+
+        auto t0 = chrono::steady_clock::now();
+        vector<int> found = schedule.search(routePairs[route].first, routePairs[route].second,
+                                            firstDay + dayOffset, flexDays, maxPrice, 1);
+        indexedTimes.push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - t0).count());
+
+        if (q < scanQueries) {
+            // What the same question costs as a scan that parses every date string
+            string from = airportCode(routePairs[route].first), to = airportCode(routePairs[route].second);
+            int target = firstDay + dayOffset;
+            t0 = chrono::steady_clock::now();
+            size_t matches = 0;
+            for (const FlightRecord& record : records) {
+                if (record.origin == from && record.destination == to &&
+                    record.price <= maxPrice && record.availableSeats >= 1 &&
+                    abs(parseDayNumber(record.date) - target) <= flexDays) {
+                    matches++;
+                }
+            }
+            scanTimes.push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - t0).count());
+            if (matches != found.size()) mismatches++;
+        }
+    }
+    printLatency("Full scan", scanTimes);
+    printLatency("Columnar schedule", indexedTimes);
+    cout << "Result mismatches: " << mismatches << endl;
+}
+
+void runFareAvailabilityBenchmark() {
+    const int flightCount = 5000;
+    const int seats = 180;
+    const int queries = 200;
+
+    AirlineReservationSystem system;
+    vector<FareClass> classes = {{"J", 25000, 180}, {"W", 12000, 150}, {"Y", 8000, 120}, {"Q", 5000, 60}};
+    for (int f = 0; f < flightCount; f++) {
+        string number = "FC" + to_string(f);
+        system.addFlight(number, "ADD", airportCode(f % 300), "01/03/2026", "08:00", "11:00", 5000, seats);
+        system.setFareClasses(number, classes);
+    }
+
+    mt19937 rng(5);
+    vector<string> booked;
+    for (int p = 0; p < flightCount * 170; p++) {
+        string passengerId = "FP" + to_string(p);
+        system.addPassenger(passengerId, "Passenger", "0900000000", "p@mail.et", "EP");
+        string fare = classes[rng() % classes.size()].code;
+        string number = system.makeReservation("FC" + to_string(rng() % flightCount), passengerId, 0, fare);
+        if (!number.empty()) booked.push_back(number);
+        if (!booked.empty() && rng() % 6 == 0) system.cancelReservation(booked[rng() % booked.size()]);
+    }
+
+    vector<double> cachedTimes, recountTimes;
+    size_t mismatches = 0, matches = 0;
+    for (int q = 0; q < queries; q++) {
+        const string& fare = classes[q % classes.size()].code;
+        int minSeats = 1 + q % 4;
+        auto t0 = chrono::steady_clock::now();
+        vector<int> cached = system.findFlightsWithFare(fare, minSeats);
+        auto t1 = chrono::steady_clock::now();
+        vector<int> recounted = system.recountFlightsWithFare(fare, minSeats);
+        auto t2 = chrono::steady_clock::now();
+        if (cached != recounted) mismatches++;
+        matches += cached.size();
+        cachedTimes.push_back(chrono::duration<double, micro>(t1 - t0).count());
+        recountTimes.push_back(chrono::duration<double, micro>(t2 - t1).count());
+    }
+
+    cout << "\nFare availability across " << flightCount << " flights x " << classes.size()
+         << " nested classes" << endl;
+    printLatency("Recount from seat maps", recountTimes);
+    printLatency("Availability cache", cachedTimes);
+    cout << "Average matching flights: " << matches / queries << ", cache mismatches: "
+         << mismatches << endl;
+}
+
+void runManifestBenchmark() {
+    const int flightCount = 400;
+    const int seats = 400;
+    const string date = "15/03/2026";
+
+    AirlineReservationSystem system;
+    mt19937 rng(3);
+    for (int f = 0; f < flightCount; f++) {
+        system.addFlight("MF" + to_string(f), "ADD", airportCode(f % 200), date, "08:00", "12:00", 9000, seats);
+    }
+    for (int p = 0; p < flightCount * seats * 85 / 100; p++) {
+        string passengerId = "MP" + to_string(p);
+        system.addPassenger(passengerId, "Passenger Number " + to_string(p), "0900000000", "p@mail.et", "EP");
+        system.makeReservation("MF" + to_string(rng() % flightCount), passengerId, 0);
+    }
+
+    // The iostream path: displayInfoByStream/displaySeatMap plus one cout line per passenger
+    const string coutPath = "manifest_bench_cout.txt", bufferPath = "manifest_bench_buffer.txt";
+    ofstream coutFile(coutPath);
+    streambuf* original = cout.rdbuf(coutFile.rdbuf());
+    auto start = chrono::steady_clock::now();
+    for (int f = 0; f < flightCount; f++) {
+        const Flight* flight = system.findFlight("MF" + to_string(f));
+        cout << "\n==== BOARDING MANIFEST ====" << endl;
+        flight->displayInfoByStream();
+        flight->displaySeatMap();
+        cout << "Passengers:" << endl;
+        for (int seat = 1; seat <= seats; seat++) {
+            if (flight->isSeatAvailable(seat)) continue;
+            string passengerId = flight->getSeatPassenger(seat);
+            const Passenger* passenger = system.findPassenger(passengerId);
+            cout << "  Seat " << seat << "  " << passengerId << "  "
+                 << (passenger == nullptr ? "(unknown)" : passenger->getName()) << endl;
+        }
+    }
+    coutFile.flush();
+    double coutMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout.rdbuf(original);
+    coutFile.close();
+
+    start = chrono::steady_clock::now();
+    int written = system.exportManifests(date, bufferPath);
+    double bufferMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    ifstream exported(bufferPath, ios::binary | ios::ate);
+    cout << "\n" << written << " manifests of " << seats << " seats (" << exported.tellg() / 1024
+         << " KB with passenger names)" << endl;
+    cout << "cout path:       " << fixed << setprecision(1) << coutMs << " ms" << endl;
+    cout << "Buffered export: " << bufferMs << " ms (" << setprecision(1) << coutMs / bufferMs
+         << "x faster)" << endl;
+    exported.close();
+    remove(coutPath.c_str());
+    remove(bufferPath.c_str());
+}
+
+void runBenchmarks() {
+    int choice;
+    cout << "\n=== Benchmarks ===" << endl;
+    cout << "1. Route Search (100k flights)" << endl;
+    cout << "2. Concurrent Seat Booking Stress Test" << endl;
+    cout << "3. Seat Booking Throughput" << endl;
+    cout << "4. Booking Storm (100k passengers)" << endl;
+    cout << "5. Reservation Log Replay" << endl;
+    cout << "6. Flexible-Date Fare Search (1M flight-days)" << endl;
+    cout << "7. Fare-Class Availability (5k flights)" << endl;
+    cout << "8. Manifest Export (400 flights)" << endl;
+    cout << "Enter your choice: ";
+    cin >> choice;
+
+    switch (choice) {
+        case 1:
+            runRouteSearchBenchmark();
+            break;
+        case 2:
+            runSeatBookingStressTest();
+            break;
+        case 3:
+            runSeatBookingThroughputBenchmark();
+            break;
+        case 4:
+            runBookingStormBenchmark();
+            break;
+        case 5:
+            runReservationLogBenchmark();
+            break;
+        case 6:
+            runFlexibleSearchBenchmark();
+            break;
+        case 7:
+            runFareAvailabilityBenchmark();
+            break;
+        case 8:
+            runManifestBenchmark();
+            break;
+        default:
+            cout << "\nInvalid choice!" << endl;
+    }
+}
+
 int main() {
     AirlineReservationSystem system;
     int choice;
 
     cout << "Welcome to Airline Reservation System" << endl;
 
+    const string journalPath = "airline_journal.txt";
+    size_t failedLine;
+    if (!system.openJournal(journalPath, failedLine)) {
+        if (failedLine == 0) cout << "Error: Cannot open " << journalPath << "!" << endl;
+        else cout << "Error: " << journalPath << " line " << failedLine << " does not replay cleanly!" << endl;
+        return 1;
+    }
+    if (system.getEventCount() > 0) {
+        cout << "Recovered " << system.getEventCount() << " reservation events from " << journalPath << endl;
+    }
+
     while (true) {
         cout << "\n=== Main Menu ===" << endl;
         cout << "1. Add Flight" << endl;
@@ -372,8 +2468,13 @@ int main() {
         cout << "5. Display All Flights" << endl;
         cout << "6. Search Flights" << endl;
         cout << "7. Display Reservation" << endl;
-        cout << "8. Exit" << endl;
-        cout << "Enter your choice (1-8): ";
+        cout << "8. Seat Map History" << endl;
+        cout << "9. Flexible Date Search" << endl;
+        cout << "10. Configure Fare Classes" << endl;
+        cout << "11. Export Day Manifests" << endl;
+        cout << "12. Benchmarks" << endl;
+        cout << "13. Exit" << endl;
+        cout << "Enter your choice (1-13): ";
         cin >> choice;
 
         switch (choice) {
@@ -399,6 +2500,21 @@ int main() {
                 system.displayReservation();
                 break;
             case 8:
+                system.displaySeatMapHistory();
+                break;
+            case 9:
+                system.searchFlexibleDates();
+                break;
+            case 10:
+                system.configureFareClasses();
+                break;
+            case 11:
+                system.exportDayManifests();
+                break;
+            case 12:
+                runBenchmarks();
+                break;
+            case 13:
                 cout << "\nThank you for using Airline Reservation System!" << endl;
                 return 0;
             default:
@@ -3,9 +3,19 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <algorithm>
+#include <chrono>
+#include <random>
+#include <array>
+#include <atomic>
+#include <thread>
 using namespace std;
 
+const int LETTER_COUNT = 10;
+const char* const LETTER_GRADES[LETTER_COUNT] = {"A+", "A", "A-", "B+", "B", "C+", "C", "D+", "D", "F"};
+const int MAX_STUDENT_CREDITS = 1000;   // credit hours one student may register in total
+
 class Course {
 private:
     string courseCode;
@@ -24,20 +34,23 @@ public:
     
     void setGrade(double newGrade) { grade = newGrade; }
 
-    // Convert numerical grade to letter grade
-    string getLetterGrade() const {
-        if (grade >= 90) return "A+";
-        else if (grade >= 85) return "A";
-        else if (grade >= 80) return "A-";
-        else if (grade >= 75) return "B+";
-        else if (grade >= 70) return "B";
-        else if (grade >= 65) return "C+";
-        else if (grade >= 60) return "C";
-        else if (grade >= 55) return "D+";
-        else if (grade >= 50) return "D";
-        else return "F";
+    // Position of the letter grade in LETTER_GRADES, best first
+    int getLetterIndex() const {
+        if (grade >= 90) return 0;
+        else if (grade >= 85) return 1;
+        else if (grade >= 80) return 2;
+        else if (grade >= 75) return 3;
+        else if (grade >= 70) return 4;
+        else if (grade >= 65) return 5;
+        else if (grade >= 60) return 6;
+        else if (grade >= 55) return 7;
+        else if (grade >= 50) return 8;
+        else return 9;
     }
 
+    // Convert numerical grade to letter grade
+    string getLetterGrade() const { return LETTER_GRADES[getLetterIndex()]; }
+
     // Convert grade to GPA points
     double getGPAPoints() const {
         if (grade >= 90) return 4.0;
@@ -51,6 +64,9 @@ public:
         else if (grade >= 50) return 1.0;
         else return 0.0;
     }
+
+    // GPA points are multiples of 0.25, so points x credits is a whole number of quarters
+    int getQualityQuarters() const { return int(getGPAPoints() * 4) * creditHours; }
 };
 
 class Student {
@@ -59,6 +75,9 @@ private:
     string name;
     string department;
     vector<Course> courses;
+    unordered_map<string, size_t> courseIndex; // courseCode -> position in courses
+    int qualityQuarters = 0;                   // sum of getQualityQuarters(), kept with courses
+    int totalCredits = 0;
 
 public:
     Student(string studentId, string studentName, string dept)
@@ -67,33 +86,45 @@ public:
     string getId() const { return id; }
     string getName() const { return name; }
     string getDepartment() const { return department; }
+    int getQualityQuarters() const { return qualityQuarters; }
+    int getTotalCredits() const { return totalCredits; }
     
-    void addCourse(const Course& course) {
+    bool hasCourse(const string& courseCode) const {
+        return courseIndex.find(courseCode) != courseIndex.end();
+    }
+
+    // Returns false if the course is already registered
+    bool addCourse(const Course& course) {
+        if (!courseIndex.emplace(course.getCode(), courses.size()).second) return false;
         courses.push_back(course);
+        qualityQuarters += course.getQualityQuarters();
+        totalCredits += course.getCredits();
+        return true;
     }
 
-    bool updateGrade(string courseCode, double newGrade) {
-        for (auto& course : courses) {
-            if (course.getCode() == courseCode) {
-                course.setGrade(newGrade);
-                return true;
-            }
+    // Position of the course in getCourses(), -1 if not registered
+    int findCourse(const string& courseCode) const {
+        auto it = courseIndex.find(courseCode);
+        return it == courseIndex.end() ? -1 : int(it->second);
+    }
+
+    // The course lookup findCourse replaced, kept for benchmarking
+    int findCourseByScan(const string& courseCode) const {
+        for (size_t i = 0; i < courses.size(); i++) {
+            if (courses[i].getCode() == courseCode) return i;
         }
-        return false;
+        return -1;
+    }
+
+    void setCourseGrade(int position, double newGrade) {
+        Course& course = courses[position];
+        qualityQuarters -= course.getQualityQuarters();
+        course.setGrade(newGrade);
+        qualityQuarters += course.getQualityQuarters();
     }
 
     double calculateGPA() const {
-        if (courses.empty()) return 0.0;
-        
-        double totalPoints = 0.0;
-        int totalCredits = 0;
-        
-        for (const auto& course : courses) {
-            totalPoints += course.getGPAPoints() * course.getCredits();
-            totalCredits += course.getCredits();
-        }
-        
-        return totalCredits > 0 ? totalPoints / totalCredits : 0.0;
+        return totalCredits > 0 ? qualityQuarters / (4.0 * totalCredits) : 0.0;
     }
 
     void displayGrades() const {
@@ -122,16 +153,218 @@ public:
     }
 };
 
+// Every student's GPA is their quarters / (4 x credits), so the cohort's GPA
+// sum is kept as whole quarters per total-credits value and only divided out
+// when read. The totals never drift, however long grades keep changing.
+struct GradeSnapshot {
+    int students = 0;
+    long long registrations = 0;
+    array<long long, MAX_STUDENT_CREDITS + 1> quartersByCredits{};  // total credits -> students' quarters
+    array<long long, LETTER_COUNT> letters{}; // registrations per LETTER_GRADES entry
+
+    // Sum of every student's GPA
+    double gpaSum() const {
+        double sum = 0.0;
+        for (int credits = 1; credits <= MAX_STUDENT_CREDITS; credits++) {
+            if (quartersByCredits[credits]) sum += quartersByCredits[credits] / (4.0 * credits);
+        }
+        return sum;
+    }
+
+    double averageGPA() const { return students > 0 ? gpaSum() / students : 0.0; }
+
+    bool matches(const GradeSnapshot& other) const {
+        return students == other.students && registrations == other.registrations && letters == other.letters &&
+               quartersByCredits == other.quartersByCredits;
+    }
+};
+
+// Cohort totals updated alongside every registration and grade change.
+// The writer bumps a version to odd before an update and back to even after
+// it (a sequence lock), so a dashboard thread can poll a consistent
+// snapshot without ever blocking grade entry.
+class GradeStatistics {
+private:
+    atomic<unsigned> version{0};
+    atomic<int> students{0};
+    atomic<long long> registrations{0};
+    array<atomic<long long>, MAX_STUDENT_CREDITS + 1> quartersByCredits{};
+    atomic<int> maxCredits{0};   // no student has more total credits
+    array<atomic<long long>, LETTER_COUNT> letters{};
+
+    template <typename T, typename D>
+    static void add(atomic<T>& counter, D delta) {
+        counter.store(counter.load(memory_order_relaxed) + delta, memory_order_relaxed);
+    }
+
+public:
+    void beginUpdate() {
+        version.store(version.load(memory_order_relaxed) + 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+    }
+
+    void endUpdate() { version.store(version.load(memory_order_relaxed) + 1, memory_order_release); }
+
+    // Called between beginUpdate and endUpdate
+    void addStudent() { add(students, 1); }
+    void addRegistration() { add(registrations, 1); }
+    // A student's totals went from (oldCredits, oldQuarters) to (newCredits, newQuarters)
+    void moveStudent(int oldCredits, int oldQuarters, int newCredits, int newQuarters) {
+        add(quartersByCredits[oldCredits], -oldQuarters);
+        add(quartersByCredits[newCredits], newQuarters);
+        if (newCredits > maxCredits.load(memory_order_relaxed)) maxCredits.store(newCredits, memory_order_relaxed);
+    }
+    void addLetter(int letter, int delta) { add(letters[letter], delta); }
+
+    GradeSnapshot snapshot() const {
+        GradeSnapshot result;
+        while (true) {
+            unsigned before = version.load(memory_order_acquire);
+            if (before & 1) {
+                this_thread::yield();
+                continue;
+            }
+            result.students = students.load(memory_order_relaxed);
+            result.registrations = registrations.load(memory_order_relaxed);
+            result.quartersByCredits.fill(0);
+            int upTo = maxCredits.load(memory_order_relaxed);
+            for (int c = 0; c <= upTo; c++) result.quartersByCredits[c] = quartersByCredits[c].load(memory_order_relaxed);
+            for (int l = 0; l < LETTER_COUNT; l++) result.letters[l] = letters[l].load(memory_order_relaxed);
+            atomic_thread_fence(memory_order_acquire);
+            if (version.load(memory_order_relaxed) == before) return result;
+        }
+    }
+};
+
 class GradeManagementSystem {
 private:
     vector<Student> students;
+    unordered_map<string, size_t> studentIndex; // id -> position in students
     map<string, pair<string, int>> courseDatabase; // courseCode -> {courseName, creditHours}
+    GradeStatistics statistics;
+
+    void setGrade(Student& student, int position, double newGrade) {
+        int oldQuarters = student.getQualityQuarters();
+        statistics.beginUpdate();
+        statistics.addLetter(student.getCourses()[position].getLetterIndex(), -1);
+        student.setCourseGrade(position, newGrade);
+        statistics.addLetter(student.getCourses()[position].getLetterIndex(), 1);
+        statistics.moveStudent(student.getTotalCredits(), oldQuarters, student.getTotalCredits(),
+                               student.getQualityQuarters());
+        statistics.endUpdate();
+    }
 
     bool isValidGrade(double grade) {
         return grade >= 0 && grade <= 100;
     }
 
 public:
+    // Adds a student without prompting; returns false if the ID is taken
+    bool addStudent(const string& id, const string& name, const string& department) {
+        if (!studentIndex.emplace(id, students.size()).second) return false;
+        students.emplace_back(id, name, department);
+        statistics.beginUpdate();
+        statistics.addStudent();
+        statistics.endUpdate();
+        return true;
+    }
+
+    // Adds a course without prompting; returns false if the code is taken or
+    // the credit hours are out of range
+    bool addCourse(const string& code, const string& name, int credits) {
+        if (courseDatabase.find(code) != courseDatabase.end() || credits < 1 || credits > MAX_STUDENT_CREDITS) {
+            return false;
+        }
+        courseDatabase[code] = {name, credits};
+        return true;
+    }
+
+    // Registers a graded course; false if the student or course is unknown,
+    // the grade is out of range, the course is already registered or it would
+    // take the student past MAX_STUDENT_CREDITS
+    bool registerCourse(const string& studentId, const string& courseCode, double grade) {
+        Student* student = findStudent(studentId);
+        auto courseIt = courseDatabase.find(courseCode);
+        if (!student || courseIt == courseDatabase.end() || !isValidGrade(grade) ||
+            student->getTotalCredits() + courseIt->second.second > MAX_STUDENT_CREDITS) {
+            return false;
+        }
+
+        Course course(courseCode, courseIt->second.first, courseIt->second.second, grade);
+        int oldCredits = student->getTotalCredits(), oldQuarters = student->getQualityQuarters();
+        if (!student->addCourse(course)) return false;
+        statistics.beginUpdate();
+        statistics.addRegistration();
+        statistics.addLetter(course.getLetterIndex(), 1);
+        statistics.moveStudent(oldCredits, oldQuarters, student->getTotalCredits(), student->getQualityQuarters());
+        statistics.endUpdate();
+        return true;
+    }
+
+    // False if the student, or the course for that student, is unknown or the grade is out of range
+    bool updateGrade(const string& studentId, const string& courseCode, double newGrade) {
+        Student* student = findStudent(studentId);
+        if (!student || !isValidGrade(newGrade)) return false;
+        int position = student->findCourse(courseCode);
+        if (position < 0) return false;
+        setGrade(*student, position, newGrade);
+        return true;
+    }
+
+    // updateGrade through linear scans of students and courses, as before the indexes
+    bool updateGradeByScan(const string& studentId, const string& courseCode, double newGrade) {
+        for (auto& student : students) {
+            if (student.getId() == studentId) {
+                int position = student.findCourseByScan(courseCode);
+                if (position < 0 || !isValidGrade(newGrade)) return false;
+                setGrade(student, position, newGrade);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Safe to call from another thread while grades are being entered
+    GradeSnapshot getStatistics() const { return statistics.snapshot(); }
+
+    // Recomputes the statistics from every course, splitting students across threads
+    GradeSnapshot recomputeStatistics(int threadCount) const {
+        threadCount = max(1, min<int>(threadCount, students.size()));
+        vector<GradeSnapshot> partial(threadCount);
+        vector<thread> workers;
+        auto count = [&](int t) {
+            size_t from = students.size() * t / threadCount, to = students.size() * (t + 1) / threadCount;
+            GradeSnapshot& part = partial[t];
+            for (size_t i = from; i < to; i++) {
+                part.students++;
+                int credits = 0, quarters = 0;
+                for (const auto& course : students[i].getCourses()) {
+                    part.registrations++;
+                    part.letters[course.getLetterIndex()]++;
+                    credits += course.getCredits();
+                    quarters += course.getQualityQuarters();
+                }
+                part.quartersByCredits[credits] += quarters;
+            }
+        };
+        for (int t = 1; t < threadCount; t++) workers.emplace_back(count, t);
+        count(0);
+        for (thread& worker : workers) worker.join();
+
+        GradeSnapshot total;
+        for (const GradeSnapshot& part : partial) {
+            total.students += part.students;
+            total.registrations += part.registrations;
+            for (int c = 0; c <= MAX_STUDENT_CREDITS; c++) total.quartersByCredits[c] += part.quartersByCredits[c];
+            for (int l = 0; l < LETTER_COUNT; l++) total.letters[l] += part.letters[l];
+        }
+        return total;
+    }
+
+    bool verifyStatistics(int threadCount) const {
+        return recomputeStatistics(threadCount).matches(getStatistics());
+    }
+
     void addStudent() {
         string id, name, department;
         
@@ -151,7 +384,7 @@ public:
         cout << "Department: ";
         getline(cin, department);
 
-        students.emplace_back(id, name, department);
+        addStudent(id, name, department);
         cout << "\nStudent added successfully!" << endl;
     }
 
@@ -174,7 +407,10 @@ public:
         cout << "Credit Hours: ";
         cin >> credits;
 
-        courseDatabase[code] = {name, credits};
+        if (!addCourse(code, name, credits)) {
+            cout << "Error: Credit hours must be between 1 and " << MAX_STUDENT_CREDITS << "!" << endl;
+            return;
+        }
         cout << "\nCourse added successfully!" << endl;
     }
 
@@ -200,6 +436,11 @@ public:
             return;
         }
 
+        if (student->hasCourse(courseCode)) {
+            cout << "Error: Course already registered for this student!" << endl;
+            return;
+        }
+
         cout << "Enter Grade (0-100): ";
         cin >> grade;
 
@@ -208,9 +449,10 @@ public:
             return;
         }
 
-        Course newCourse(courseCode, courseIt->second.first, 
-                        courseIt->second.second, grade);
-        student->addCourse(newCourse);
+        if (!registerCourse(studentId, courseCode, grade)) {
+            cout << "Error: Student would exceed " << MAX_STUDENT_CREDITS << " credit hours!" << endl;
+            return;
+        }
         cout << "\nCourse registered successfully!" << endl;
     }
 
@@ -238,7 +480,7 @@ public:
             return;
         }
 
-        if (student->updateGrade(courseCode, newGrade)) {
+        if (updateGrade(studentId, courseCode, newGrade)) {
             cout << "\nGrade updated successfully!" << endl;
         } else {
             cout << "Error: Course not found for this student!" << endl;
@@ -283,42 +525,170 @@ public:
         }
 
         cout << "\n=== Grade Statistics ===" << endl;
-        
-        // Calculate overall statistics
-        double totalGPA = 0.0;
-        int totalStudents = students.size();
-        map<string, int> gradeDistribution;
-        
-        for (const auto& student : students) {
-            totalGPA += student.calculateGPA();
-            
-            for (const auto& course : student.getCourses()) {
-                gradeDistribution[course.getLetterGrade()]++;
-            }
-        }
+        GradeSnapshot stats = getStatistics();
 
         // Display statistics
-        cout << "Total Students: " << totalStudents << endl;
+        cout << "Total Students: " << stats.students << endl;
         cout << "Average GPA: " << fixed << setprecision(2) 
-             << (totalGPA / totalStudents) << endl;
+             << stats.averageGPA() << endl;
 
         cout << "\nGrade Distribution:" << endl;
-        for (const auto& grade : gradeDistribution) {
-            cout << grade.first << ": " << grade.second << " students" << endl;
+        for (int l = 0; l < LETTER_COUNT; l++) {
+            if (stats.letters[l] > 0) cout << LETTER_GRADES[l] << ": " << stats.letters[l] << " students" << endl;
+        }
+    }
+
+    void verifyStatistics() const {
+        int threads = max(1u, thread::hardware_concurrency());
+        if (verifyStatistics(threads)) {
+            cout << "\nStatistics match a full recount." << endl;
+        } else {
+            cout << "Error: Statistics differ from a full recount!" << endl;
         }
     }
 
 private:
     Student* findStudent(const string& id) {
-        for (auto& student : students) {
-            if (student.getId() == id) {
-                return &student;
-            }
-        }
-        return nullptr;
+        auto it = studentIndex.find(id);
+        return it == studentIndex.end() ? nullptr : &students[it->second];
     }
 };
 
+// Benchmark helper: microseconds per operation over a batch
+double microsPerOp(chrono::steady_clock::time_point start, size_t ops) {
+    return chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / max<size_t>(1, ops);
+}
+
+const int BENCHMARK_STUDENTS = 40000;
+
+// Adds a 40k-student faculty and 300 courses; returns a shuffled grade
+// entry (studentId, courseCode) for ten courses per student
+vector<pair<string, string>> setUpFaculty(GradeManagementSystem& system, mt19937& rng) {
+    const int courseCount = 300;
+    const int coursesPerStudent = 10;
+
+    for (int c = 0; c < courseCount; c++) system.addCourse("C" + to_string(c), "Course", 1 + c % 4);
+    for (int s = 0; s < BENCHMARK_STUDENTS; s++) system.addStudent("S" + to_string(s), "Student", "Engineering");
+
+    vector<pair<string, string>> entries;
+    for (int s = 0; s < BENCHMARK_STUDENTS; s++) {
+        int first = rng() % courseCount;
+        for (int k = 0; k < coursesPerStudent; k++) {
+            entries.push_back({"S" + to_string(s), "C" + to_string((first + k * 7) % courseCount)});
+        }
+    }
+    shuffle(entries.begin(), entries.end(), rng);
+    return entries;
+}
+
+void runGradeEntryBenchmark() {
+    const int scanEntries = 2000;
+
+    GradeManagementSystem system;
+    mt19937 rng(49);
+    vector<pair<string, string>> entries = setUpFaculty(system, rng);
+
+    auto start = chrono::steady_clock::now();
+    size_t registered = 0;
+    for (const auto& entry : entries) registered += system.registerCourse(entry.first, entry.second, rng() % 101);
+    double registerUs = microsPerOp(start, entries.size());
+
+    start = chrono::steady_clock::now();
+    size_t updated = 0;
+    for (const auto& entry : entries) updated += system.updateGrade(entry.first, entry.second, rng() % 101);
+    double indexedUs = microsPerOp(start, entries.size());
+
+    start = chrono::steady_clock::now();
+    size_t scanned = 0;
+    for (int e = 0; e < scanEntries; e++) {
+        scanned += system.updateGradeByScan(entries[e].first, entries[e].second, rng() % 101);
+    }
+    double scanUs = microsPerOp(start, scanEntries);
+
+    cout << "\n" << BENCHMARK_STUDENTS << " students, " << entries.size() << " grade entries" << endl;
+    cout << fixed << setprecision(2);
+    cout << "Register with indexes: " << registerUs << " us/entry (" << registered << " registered)" << endl;
+    cout << "Update with indexes:   " << indexedUs << " us/entry (" << updated << " updated), "
+         << indexedUs * entries.size() / 1000 << " ms for all" << endl;
+    cout << "Update by scanning:    " << scanUs << " us/entry (" << scanned << " of " << scanEntries
+         << " sampled), about " << setprecision(1) << scanUs * entries.size() / 1e6 << " s for all" << endl;
+}
+
+void runStatisticsBenchmark() {
+    const int recounts = 10;
+    const int polls = 100000;
+
+    GradeManagementSystem system;
+    mt19937 rng(50);
+    vector<pair<string, string>> entries = setUpFaculty(system, rng);
+    for (const auto& entry : entries) system.registerCourse(entry.first, entry.second, rng() % 101);
+
+    auto start = chrono::steady_clock::now();
+    volatile double sink = 0;   // keeps each read inside the timed region
+    for (int r = 0; r < recounts; r++) sink = sink + system.recomputeStatistics(1).averageGPA();
+    double recountUs = microsPerOp(start, recounts);
+
+    int threadCount = max(4u, thread::hardware_concurrency());
+    start = chrono::steady_clock::now();
+    for (int r = 0; r < recounts; r++) sink = sink + system.recomputeStatistics(threadCount).averageGPA();
+    double parallelUs = microsPerOp(start, recounts);
+
+    start = chrono::steady_clock::now();
+    for (int p = 0; p < polls; p++) sink = sink + system.getStatistics().averageGPA();
+    double pollUs = microsPerOp(start, polls);
+
+    // A dashboard polls while every grade is re-entered; each snapshot
+    // must count exactly one letter per registration
+    atomic<bool> done{false};
+    long long snapshots = 0, torn = 0;
+    thread dashboard([&]() {
+        while (!done.load()) {
+            GradeSnapshot stats = system.getStatistics();
+            long long letters = 0;
+            for (long long count : stats.letters) letters += count;
+            torn += letters != stats.registrations;
+            snapshots++;
+            this_thread::yield();
+        }
+    });
+    start = chrono::steady_clock::now();
+    for (const auto& entry : entries) system.updateGrade(entry.first, entry.second, rng() % 101);
+    double updateMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    done = true;
+    dashboard.join();
+
+    bool verified = system.verifyStatistics(threadCount);
+
+    cout << "\n" << BENCHMARK_STUDENTS << " students, " << entries.size() << " registrations" << endl;
+    cout << fixed << setprecision(2);
+    cout << "Recount from scratch: " << recountUs / 1000 << " ms" << endl;
+    cout << "Recount on " << threadCount << " threads:  " << parallelUs / 1000 << " ms" << endl;
+    cout << "Running totals:       " << pollUs << " us" << endl;
+    cout << "Re-entering every grade while polled: " << updateMs << " ms, " << snapshots << " snapshots, "
+         << torn << " inconsistent" << endl;
+    cout << "Running totals match a parallel recount: " << (verified ? "yes" : "NO") << endl;
+}
+
+void runBenchmarks() {
+    int choice;
+    cout << "\n=== Benchmarks ===" << endl;
+    cout << "1. Bulk Grade Entry (40k students)" << endl;
+    cout << "2. Statistics (40k students)" << endl;
+    cout << "Enter your choice: ";
+    cin >> choice;
+
+    switch (choice) {
+        case 1:
+            runGradeEntryBenchmark();
+            break;
+        case 2:
+            runStatisticsBenchmark();
+            break;
+        default:
+            cout << "\nInvalid choice!" << endl;
+    }
+}
+
 int main() {
     GradeManagementSystem system;
     int choice;
@@ -333,8 +703,10 @@ int main() {
         cout << "4. Update Grade" << endl;
         cout << "5. Generate Grade Report" << endl;
         cout << "6. Show Statistics" << endl;
-        cout << "7. Exit" << endl;
-        cout << "Enter your choice (1-7): ";
+        cout << "7. Verify Statistics" << endl;
+        cout << "8. Benchmarks" << endl;
+        cout << "9. Exit" << endl;
+        cout << "Enter your choice (1-9): ";
         cin >> choice;
 
         switch (choice) {
@@ -357,6 +729,12 @@ int main() {
                 system.showStatistics();
                 break;
             case 7:
+                system.verifyStatistics();
+                break;
+            case 8:
+                runBenchmarks();
+                break;
+            case 9:
                 cout << "\nThank you for using Student Grade Management System!" << endl;
                 return 0;
             default:
@@ -1,12 +1,365 @@
 #include <iostream>
 #include <iomanip>
+#include <fstream>
 #include <string>
 #include <vector>
+#include <array>
 #include <map>
+#include <set>
+#include <unordered_map>
 #include <ctime>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <cstdio>
 #include <algorithm>
+#include <thread>
+#include <atomic>
 using namespace std;
 
+const int SLOT_MINUTES = 30;
+const int SLOTS_PER_DAY = 24 * 60 / SLOT_MINUTES;  // fits one 64-bit word
+
+// Converts "DD/MM/YYYY" into a day number (days since 01/01/1970), -1 if invalid
+int parseDayNumber(const string& date) {
+    int d, m, y;
+    char s1, s2;
+    if (sscanf(date.c_str(), "%d%c%d%c%d", &d, &s1, &m, &s2, &y) != 5 ||
+        s1 != '/' || s2 != '/' || m < 1 || m > 12 || d < 1) {
+        return -1;
+    }
+    static const int monthDays[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leap = y % 4 == 0 && (y % 100 != 0 || y % 400 == 0);
+    if (d > monthDays[m - 1] + (m == 2 && leap)) return -1;
+    y -= m <= 2;
+    int era = (y >= 0 ? y : y - 399) / 400;
+    int yoe = y - era * 400;
+    int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+// Converts "HH:MM" into minutes after midnight, -1 if invalid
+int parseMinutes(const string& time) {
+    int h, m;
+    char sep;
+    if (sscanf(time.c_str(), "%d%c%d", &h, &sep, &m) != 3 || sep != ':' ||
+        h < 0 || h > 23 || m < 0 || m > 59) {
+        return -1;
+    }
+    return h * 60 + m;
+}
+
+// 0 = Sunday ... 6 = Saturday; 01/01/1970 was a Thursday
+int weekdayOf(int dayNumber) {
+    return ((dayNumber % 7) + 11) % 7;
+}
+
+const char* weekdayName(int weekday) {
+    static const char* names[] = {"Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday"};
+    return names[weekday];
+}
+
+// Accepts full or three-letter English day names, -1 if unknown
+int parseWeekday(const string& name) {
+    static const char* names[] = {"sun", "mon", "tue", "wed", "thu", "fri", "sat"};
+    if (name.size() < 3) return -1;
+    string prefix;
+    for (int i = 0; i < 3; i++) prefix += tolower(name[i]);
+    for (int d = 0; d < 7; d++) {
+        if (prefix == names[d]) return d;
+    }
+    return -1;
+}
+
+// Bit mask of the slots covered by "HH:MM-HH:MM" (the end may be 24:00), 0 if invalid
+uint64_t parseSlotRange(const string& range) {
+    int h1, m1, h2, m2;
+    if (sscanf(range.c_str(), "%d:%d - %d:%d", &h1, &m1, &h2, &m2) != 4 ||
+        h1 < 0 || h1 > 23 || m1 < 0 || m1 > 59 || h2 < 0 || m2 < 0 || m2 > 59 ||
+        h2 * 60 + m2 > 24 * 60) {
+        return 0;
+    }
+    int from = (h1 * 60 + m1) / SLOT_MINUTES;
+    int to = (h2 * 60 + m2 + SLOT_MINUTES - 1) / SLOT_MINUTES;
+    if (from < 0 || to > SLOTS_PER_DAY || from >= to) return 0;
+    uint64_t upTo = to == 64 ? ~0ULL : (1ULL << to) - 1;
+    return upTo & ~((1ULL << from) - 1);
+}
+
+// Inverse of parseDayNumber
+string formatDayNumber(int day) {
+    day += 719468;
+    int era = (day >= 0 ? day : day - 146096) / 146097;
+    int doe = day - era * 146097;
+    int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int mp = (5 * doy + 2) / 153;
+    int d = doy - (153 * mp + 2) / 5 + 1;
+    int m = mp + (mp < 10 ? 3 : -9);
+    int y = yoe + era * 400 + (m <= 2);
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%02d/%02d/%04d", d, m, y);
+    return buffer;
+}
+
+string formatSlot(int slot) {
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "%02d:%02d", slot * SLOT_MINUTES / 60, slot * SLOT_MINUTES % 60);
+    return buffer;
+}
+
+// Weekly working hours plus the booked slots of every day as one word per day,
+// so checking, booking and cancelling a slot are single bit operations. Days
+// are kept in one dense range that a booking may stretch by at most
+// MAX_GAP_DAYS; bookings further out go to a side table, so a stray far-off
+// date costs one entry instead of a word for every day in between.
+class DoctorCalendar {
+private:
+    static const int MAX_GAP_DAYS = 366;
+
+    uint64_t weeklyHours[7];
+    int firstDay;
+    vector<uint64_t> booked;                 // day firstDay + i -> booked slot bits
+    unordered_map<int, uint64_t> outlying;   // day outside the dense range -> booked slot bits
+
+    uint64_t& bookedWord(int day) {
+        if (booked.empty()) firstDay = day;
+        int offset = day - firstDay;
+        if (offset >= 0 && offset < int(booked.size())) return booked[offset];
+        if (offset < -MAX_GAP_DAYS || offset >= int(booked.size()) + MAX_GAP_DAYS) return outlying[day];
+
+        if (offset < 0) {
+            booked.insert(booked.begin(), -offset, 0);
+            firstDay = day;
+        } else {
+            booked.resize(offset + 1, 0);
+        }
+        // Days the range now covers move in from the side table
+        for (auto it = outlying.begin(); it != outlying.end();) {
+            if (it->first < firstDay || it->first - firstDay >= int(booked.size())) {
+                ++it;
+                continue;
+            }
+            booked[it->first - firstDay] = it->second;
+            it = outlying.erase(it);
+        }
+        return booked[day - firstDay];
+    }
+
+public:
+    DoctorCalendar() : firstDay(0) {
+        fill(weeklyHours, weeklyHours + 7, 0);
+    }
+
+    void addWorkingHours(int weekday, uint64_t slots) { weeklyHours[weekday] |= slots; }
+    uint64_t workingHours(int weekday) const { return weeklyHours[weekday]; }
+
+    uint64_t bookedSlots(int day) const {
+        int offset = day - firstDay;
+        if (offset >= 0 && offset < int(booked.size())) return booked[offset];
+        if (outlying.empty()) return 0;
+        auto it = outlying.find(day);
+        return it == outlying.end() ? 0 : it->second;
+    }
+
+    uint64_t freeSlots(int day) const {
+        return day < 0 ? 0 : weeklyHours[weekdayOf(day)] & ~bookedSlots(day);
+    }
+
+    bool isFree(int day, int slot) const {
+        return slot >= 0 && slot < SLOTS_PER_DAY && ((freeSlots(day) >> slot) & 1);
+    }
+
+    bool book(int day, int slot) {
+        if (!isFree(day, slot)) return false;
+        bookedWord(day) |= 1ULL << slot;
+        return true;
+    }
+
+    bool release(int day, int slot) {
+        if (slot < 0 || slot >= SLOTS_PER_DAY || !((bookedSlots(day) >> slot) & 1)) return false;
+        bookedWord(day) &= ~(1ULL << slot);
+        return true;
+    }
+
+    // First free slot at or after the absolute slot (day * SLOTS_PER_DAY + slot),
+    // looking at most maxDays ahead; -1 if none
+    int nextFreeSlot(int fromSlot, int maxDays) const {
+        int day = fromSlot / SLOTS_PER_DAY;
+        uint64_t mask = freeSlots(day) & (~0ULL << (fromSlot % SLOTS_PER_DAY));
+        for (int d = day; d <= day + maxDays; d++) {
+            if (d > day) mask = freeSlots(d);
+            if (mask) return d * SLOTS_PER_DAY + __builtin_ctzll(mask);
+        }
+        return -1;
+    }
+
+    // Free slots in the Monday-to-Sunday week containing day
+    int freeSlotsInWeek(int day) const {
+        int monday = day - (weekdayOf(day) + 6) % 7;
+        int count = 0;
+        for (int d = monday; d < monday + 7; d++) count += __builtin_popcountll(freeSlots(d));
+        return count;
+    }
+};
+
+enum class ClinicalEntryType : uint8_t { Condition, Medication, Allergy };
+
+// Append-only clinical events kept outside Patient. Each patient owns a chain of
+// 64-byte blocks holding a byte stream of entries; an entry is its type, the
+// varint time delta since the chain's previous entry and the varint id of its
+// text in a shared term dictionary, so repeated diagnoses and drug names are
+// stored once.
+class ClinicalHistoryStore {
+private:
+    static const uint32_t NO_BLOCK = 0xFFFFFFFF;
+    static const int BLOCK_BYTES = 60;
+
+    struct Block {
+        uint32_t next;
+        uint8_t data[BLOCK_BYTES];
+    };
+
+    struct Chain {
+        uint32_t head;
+        uint32_t tail;
+        uint32_t tailUsed;
+        uint32_t entries;
+        int64_t lastTimestamp;
+    };
+
+    vector<Block> blocks;
+    vector<Chain> chains;
+    unordered_map<string, uint32_t> termIds;
+    vector<string> terms;
+
+    void appendByte(Chain& chain, uint8_t value) {
+        if (chain.tail == NO_BLOCK || chain.tailUsed == BLOCK_BYTES) {
+            uint32_t block = blocks.size();
+            blocks.push_back(Block());
+            blocks.back().next = NO_BLOCK;
+            if (chain.tail == NO_BLOCK) chain.head = block;
+            else blocks[chain.tail].next = block;
+            chain.tail = block;
+            chain.tailUsed = 0;
+        }
+        blocks[chain.tail].data[chain.tailUsed++] = value;
+    }
+
+    void appendVarint(Chain& chain, uint64_t value) {
+        while (value >= 0x80) {
+            appendByte(chain, uint8_t(value) | 0x80);
+            value >>= 7;
+        }
+        appendByte(chain, uint8_t(value));
+    }
+
+    uint32_t internTerm(const string& text) {
+        auto it = termIds.find(text);
+        if (it != termIds.end()) return it->second;
+        termIds.emplace(text, terms.size());
+        terms.push_back(text);
+        return terms.size() - 1;
+    }
+
+    // Sequential reader over one chain's byte stream
+    struct Reader {
+        const vector<Block>& blocks;
+        uint32_t block;
+        int offset;
+
+        uint8_t next() {
+            if (offset == BLOCK_BYTES) {
+                block = blocks[block].next;
+                offset = 0;
+            }
+            return blocks[block].data[offset++];
+        }
+
+        uint64_t varint() {
+            uint64_t value = 0;
+            for (int shift = 0;; shift += 7) {
+                uint8_t byte = next();
+                value |= uint64_t(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) return value;
+            }
+        }
+    };
+
+public:
+    // New empty history; the handle is what Patient keeps
+    uint32_t createHistory() {
+        chains.push_back({NO_BLOCK, NO_BLOCK, 0, 0, 0});
+        return chains.size() - 1;
+    }
+
+    void append(uint32_t handle, ClinicalEntryType type, const string& text, time_t when = time(0)) {
+        Chain& chain = chains[handle];
+        int64_t timestamp = max<int64_t>(when, chain.lastTimestamp);
+        appendByte(chain, uint8_t(type));
+        appendVarint(chain, timestamp - chain.lastTimestamp);
+        appendVarint(chain, internTerm(text));
+        chain.lastTimestamp = timestamp;
+        chain.entries++;
+    }
+
+    // Streams entries oldest first without materializing the history;
+    // visit(type, timestamp, text) is called once per entry
+    template <typename Visitor>
+    void forEach(uint32_t handle, Visitor visit) const {
+        const Chain& chain = chains[handle];
+        Reader reader{blocks, chain.head, 0};
+        int64_t timestamp = 0;
+        for (uint32_t i = 0; i < chain.entries; i++) {
+            ClinicalEntryType type = ClinicalEntryType(reader.next());
+            timestamp += reader.varint();
+            const string& text = terms[reader.varint()];
+            visit(type, time_t(timestamp), text);
+        }
+    }
+
+    uint32_t entryCount(uint32_t handle) const { return chains[handle].entries; }
+
+    // Approximate heap footprint: blocks, chain headers and the term dictionary
+    size_t memoryBytes() const {
+        size_t bytes = blocks.capacity() * sizeof(Block) + chains.capacity() * sizeof(Chain) +
+                       terms.capacity() * sizeof(string);
+        for (const string& term : terms) bytes += (term.capacity() > 15 ? term.capacity() + 1 : 0);
+        return bytes + termIds.size() * (sizeof(string) + 16) + termIds.bucket_count() * sizeof(void*);
+    }
+};
+
+// A small vocabulary stored once; records keep a 16-bit id, so equality is an
+// integer compare and the text is shared by every record that uses it
+class AttributeTable {
+private:
+    unordered_map<string, uint16_t> ids;
+    vector<string> values;
+
+public:
+    static const size_t MAX_VALUES = 65536;
+
+    // Id of the value, added if new; -1 once all 16-bit ids are taken
+    int intern(const string& value) {
+        auto it = ids.find(value);
+        if (it != ids.end()) return it->second;
+        if (values.size() >= MAX_VALUES) return -1;
+        ids.emplace(value, values.size());
+        values.push_back(value);
+        return values.size() - 1;
+    }
+
+    // -1 if the value was never interned
+    int find(const string& value) const {
+        auto it = ids.find(value);
+        return it == ids.end() ? -1 : it->second;
+    }
+
+    const string& valueOf(uint16_t id) const { return values[id]; }
+    size_t size() const { return values.size(); }
+};
+
 class Patient {
 private:
     string id;
@@ -15,34 +368,22 @@ private:
     string gender;
     string phone;
     string address;
-    string bloodGroup;
-    vector<string> medicalHistory;
-    vector<string> currentMedications;
-    vector<string> allergies;
+    uint16_t bloodGroup;     // in the system's blood group table
+    uint32_t historyHandle;  // medical history, medications and allergies in ClinicalHistoryStore
 
 public:
     Patient(string pId, string pName, int pAge, string pGender, string pPhone, 
-           string pAddress, string blood)
+           string pAddress, uint16_t blood, uint32_t history)
         : id(pId), name(pName), age(pAge), gender(pGender), phone(pPhone),
-          address(pAddress), bloodGroup(blood) {}
+          address(pAddress), bloodGroup(blood), historyHandle(history) {}
 
     string getId() const { return id; }
     string getName() const { return name; }
     string getPhone() const { return phone; }
+    uint16_t getBloodGroupId() const { return bloodGroup; }
+    uint32_t getHistoryHandle() const { return historyHandle; }
 
-    void addMedicalHistory(const string& condition) {
-        medicalHistory.push_back(condition);
-    }
-
-    void addMedication(const string& medication) {
-        currentMedications.push_back(medication);
-    }
-
-    void addAllergy(const string& allergy) {
-        allergies.push_back(allergy);
-    }
-
-    void displayInfo() const {
+    void displayInfo(const ClinicalHistoryStore& history, const AttributeTable& bloodGroups) const {
         cout << "\nPatient Details:" << endl;
         cout << "ID: " << id << endl;
         cout << "Name: " << name << endl;
@@ -50,31 +391,24 @@ public:
         cout << "Gender: " << gender << endl;
         cout << "Phone: " << phone << endl;
         cout << "Address: " << address << endl;
-        cout << "Blood Group: " << bloodGroup << endl;
+        cout << "Blood Group: " << bloodGroups.valueOf(bloodGroup) << endl;
 
-        cout << "\nMedical History:" << endl;
-        if (medicalHistory.empty()) cout << "No medical history recorded." << endl;
-        else {
-            for (const auto& condition : medicalHistory) {
-                cout << "- " << condition << endl;
-            }
-        }
-
-        cout << "\nCurrent Medications:" << endl;
-        if (currentMedications.empty()) cout << "No current medications." << endl;
-        else {
-            for (const auto& medication : currentMedications) {
-                cout << "- " << medication << endl;
-            }
-        }
+        displayEntries(history, ClinicalEntryType::Condition, "Medical History", "No medical history recorded.");
+        displayEntries(history, ClinicalEntryType::Medication, "Current Medications", "No current medications.");
+        displayEntries(history, ClinicalEntryType::Allergy, "Allergies", "No known allergies.");
+    }
 
-        cout << "\nAllergies:" << endl;
-        if (allergies.empty()) cout << "No known allergies." << endl;
-        else {
-            for (const auto& allergy : allergies) {
-                cout << "- " << allergy << endl;
-            }
-        }
+private:
+    void displayEntries(const ClinicalHistoryStore& history, ClinicalEntryType wanted,
+                        const string& title, const string& emptyMessage) const {
+        cout << "\n" << title << ":" << endl;
+        bool any = false;
+        history.forEach(historyHandle, [&](ClinicalEntryType type, time_t, const string& text) {
+            if (type != wanted) return;
+            cout << "- " << text << endl;
+            any = true;
+        });
+        if (!any) cout << emptyMessage << endl;
     }
 };
 
@@ -82,36 +416,46 @@ class Doctor {
 private:
     string id;
     string name;
-    string specialization;
+    uint16_t specialization;  // in the system's specialization table
     string phone;
     string email;
-    vector<pair<string, string>> schedule; // day, time slots
+    vector<pair<uint8_t, string>> schedule; // weekday, time slots
+    DoctorCalendar calendar;
     double consultationFee;
 
 public:
-    Doctor(string dId, string dName, string spec, string dPhone, string dEmail, double fee)
+    Doctor(string dId, string dName, uint16_t spec, string dPhone, string dEmail, double fee)
         : id(dId), name(dName), specialization(spec), phone(dPhone),
           email(dEmail), consultationFee(fee) {}
 
     string getId() const { return id; }
     string getName() const { return name; }
-    string getSpecialization() const { return specialization; }
+    uint16_t getSpecializationId() const { return specialization; }
     double getConsultationFee() const { return consultationFee; }
 
-    void addSchedule(const string& day, const string& timeSlot) {
-        schedule.emplace_back(day, timeSlot);
+    // day is a weekday name and timeSlot a "HH:MM-HH:MM" range
+    bool addSchedule(const string& day, const string& timeSlot) {
+        int weekday = parseWeekday(day);
+        uint64_t slots = parseSlotRange(timeSlot);
+        if (weekday < 0 || slots == 0) return false;
+        schedule.emplace_back(weekday, timeSlot);
+        calendar.addWorkingHours(weekday, slots);
+        return true;
     }
 
-    bool isAvailable(const string& day, const string& timeSlot) const {
-        return find(schedule.begin(), schedule.end(), 
-                   make_pair(day, timeSlot)) != schedule.end();
-    }
+    bool isAvailable(int dayNumber, int slot) const { return calendar.isFree(dayNumber, slot); }
+    bool bookSlot(int dayNumber, int slot) { return calendar.book(dayNumber, slot); }
+    bool releaseSlot(int dayNumber, int slot) { return calendar.release(dayNumber, slot); }
+    uint64_t getFreeSlots(int dayNumber) const { return calendar.freeSlots(dayNumber); }
+    int getFreeSlotsInWeek(int dayNumber) const { return calendar.freeSlotsInWeek(dayNumber); }
+    int getNextFreeSlot(int fromSlot, int maxDays) const { return calendar.nextFreeSlot(fromSlot, maxDays); }
+    uint64_t getWorkingHours(int weekday) const { return calendar.workingHours(weekday); }
 
-    void displayInfo() const {
+    void displayInfo(const AttributeTable& specializations) const {
         cout << "\nDoctor Details:" << endl;
         cout << "ID: " << id << endl;
         cout << "Name: " << name << endl;
-        cout << "Specialization: " << specialization << endl;
+        cout << "Specialization: " << specializations.valueOf(specialization) << endl;
         cout << "Phone: " << phone << endl;
         cout << "Email: " << email << endl;
         cout << "Consultation Fee: ETB " << fixed << setprecision(2) << consultationFee << endl;
@@ -120,12 +464,19 @@ public:
         if (schedule.empty()) cout << "No schedule set." << endl;
         else {
             for (const auto& slot : schedule) {
-                cout << slot.first << ": " << slot.second << endl;
+                cout << weekdayName(slot.first) << ": " << slot.second << endl;
             }
         }
     }
 };
 
+enum class AppointmentStatus : uint8_t { Scheduled, Completed, Cancelled };
+
+const char* statusName(AppointmentStatus status) {
+    static const char* names[] = {"Scheduled", "Completed", "Cancelled"};
+    return names[int(status)];
+}
+
 class Appointment {
 private:
     string appointmentId;
@@ -134,23 +485,24 @@ private:
     string date;
     string timeSlot;
     bool confirmed;
-    string status; // Scheduled, Completed, Cancelled
+    AppointmentStatus status;
     string notes;
 
 public:
     Appointment(string appId, string pId, string dId, string appDate, string time)
         : appointmentId(appId), patientId(pId), doctorId(dId),
-          date(appDate), timeSlot(time), confirmed(false), status("Scheduled") {}
+          date(appDate), timeSlot(time), confirmed(false), status(AppointmentStatus::Scheduled) {}
 
     string getAppointmentId() const { return appointmentId; }
     string getPatientId() const { return patientId; }
     string getDoctorId() const { return doctorId; }
     string getDate() const { return date; }
-    string getStatus() const { return status; }
+    string getTimeSlot() const { return timeSlot; }
+    AppointmentStatus getStatus() const { return status; }
 
     void confirm() { confirmed = true; }
-    void cancel() { status = "Cancelled"; }
-    void complete() { status = "Completed"; }
+    void cancel() { status = AppointmentStatus::Cancelled; }
+    void complete() { status = AppointmentStatus::Completed; }
     void addNotes(const string& doctorNotes) { notes = doctorNotes; }
 
     void displayInfo() const {
@@ -160,13 +512,290 @@ public:
         cout << "Doctor ID: " << doctorId << endl;
         cout << "Date: " << date << endl;
         cout << "Time: " << timeSlot << endl;
-        cout << "Status: " << status << endl;
+        cout << "Status: " << statusName(status) << endl;
         if (!notes.empty()) {
             cout << "Notes: " << notes << endl;
         }
     }
 };
 
+// Doctors grouped by interned specialization, each group keeping an ordered set
+// of (key, doctor) valid from the group's cursor, which only moves forward. The
+// key is the doctor's next free slot, or, when nothing was free within the
+// horizon, the first slot not yet searched, which is searched again once a
+// query's horizon reaches it. Bookings and cancellations adjust one entry; a
+// query after the cursor only re-scans the doctors whose key it has passed.
+// Queries before the cursor leave the queue alone and read per-slot counts of
+// working and booked doctors, one day at a time.
+class EarliestSlotIndex {
+private:
+    struct Group {
+        int cursor;  // absolute slot every queued key is valid from
+        vector<int> doctors;
+        set<pair<int, int>> queue;
+        array<array<int, SLOTS_PER_DAY>, 7> working;          // weekday -> slot -> doctors working
+        unordered_map<int, array<int, SLOTS_PER_DAY>> booked;  // day -> slot -> doctors booked
+    };
+
+    vector<Group> groups;      // specialization id -> group
+    vector<int> groupOf;       // doctor -> group
+    vector<int> queuedKey;     // doctor -> key in the group queue
+    vector<bool> searchedTo;   // doctor -> key marks the end of a fruitless search
+    vector<array<uint64_t, 7>> hoursOf;  // doctor -> working hours counted in the group
+
+    static const int HORIZON_DAYS = 366;
+
+    // One past the last slot a query from fromSlot may return
+    static int horizonEnd(int fromSlot) { return (fromSlot / SLOTS_PER_DAY + HORIZON_DAYS + 1) * SLOTS_PER_DAY; }
+
+    void refresh(const vector<Doctor>& doctors, int doctor, int fromSlot) {
+        Group& group = groups[groupOf[doctor]];
+        group.queue.erase({queuedKey[doctor], doctor});
+        int slot = doctors[doctor].getNextFreeSlot(fromSlot, HORIZON_DAYS);
+        searchedTo[doctor] = slot < 0;
+        queuedKey[doctor] = slot >= 0 ? slot : horizonEnd(fromSlot);
+        group.queue.insert({queuedKey[doctor], doctor});
+    }
+
+    void countBooking(int doctor, int slot, int delta) {
+        Group& group = groups[groupOf[doctor]];
+        auto it = group.booked.find(slot / SLOTS_PER_DAY);
+        if (it == group.booked.end()) {
+            it = group.booked.emplace(slot / SLOTS_PER_DAY, array<int, SLOTS_PER_DAY>()).first;
+            it->second.fill(0);
+        }
+        it->second[slot % SLOTS_PER_DAY] += delta;
+    }
+
+    // Answer from the queue for a query from `from` onwards, from >= cursor
+    pair<int, int> settle(const vector<Doctor>& doctors, Group& g, int from, int limit) {
+        while (!g.queue.empty()) {
+            pair<int, int> top = *g.queue.begin();
+            if (top.first < from) refresh(doctors, top.second, from);
+            else if (searchedTo[top.second] && top.first < limit) refresh(doctors, top.second, top.first);
+            else break;
+        }
+        if (g.queue.empty()) return {-1, -1};
+        pair<int, int> top = *g.queue.begin();
+        return searchedTo[top.second] || top.first >= limit ? make_pair(-1, -1) : top;
+    }
+
+    // Earliest (slot, doctor) in [from, to) from the slot counts, {-1, -1} if none
+    pair<int, int> earliestByCounts(const vector<Doctor>& doctors, const Group& g, int from, int to) const {
+        for (int day = from / SLOTS_PER_DAY; day * SLOTS_PER_DAY < to; day++) {
+            const array<int, SLOTS_PER_DAY>& working = g.working[weekdayOf(day)];
+            auto it = g.booked.find(day);
+            uint64_t free = 0;
+            for (int slot = 0; slot < SLOTS_PER_DAY; slot++) {
+                int booked = it == g.booked.end() ? 0 : it->second[slot];
+                if (working[slot] > booked) free |= 1ULL << slot;
+            }
+            int first = max(from - day * SLOTS_PER_DAY, 0), last = min(to - day * SLOTS_PER_DAY, SLOTS_PER_DAY);
+            free &= (~0ULL << first) & (last == 64 ? ~0ULL : (1ULL << last) - 1);
+            if (!free) continue;
+            int slot = __builtin_ctzll(free);
+            for (int doctor : g.doctors) {
+                if (doctors[doctor].isAvailable(day, slot)) return {day * SLOTS_PER_DAY + slot, doctor};
+            }
+        }
+        return {-1, -1};
+    }
+
+public:
+    // Group of the specialization, -1 if no doctor has it
+    int findSpecialization(const AttributeTable& specializations, const string& name) const {
+        int group = specializations.find(name);
+        return group >= 0 && group < int(groups.size()) && !groups[group].doctors.empty() ? group : -1;
+    }
+
+    void addDoctor(const vector<Doctor>& doctors, int doctor) {
+        int group = doctors[doctor].getSpecializationId();
+        if (group >= int(groups.size())) groups.resize(group + 1, Group{0, {}, {}, {}, {}});
+        groupOf.push_back(group);
+        queuedKey.push_back(-1);
+        searchedTo.push_back(false);
+        hoursOf.push_back({});
+        groups[group].doctors.push_back(doctor);
+        onScheduleChanged(doctors, doctor);
+    }
+
+    const vector<int>& doctorsIn(int group) const { return groups[group].doctors; }
+
+    // Working hours changed
+    void onScheduleChanged(const vector<Doctor>& doctors, int doctor) {
+        Group& group = groups[groupOf[doctor]];
+        for (int weekday = 0; weekday < 7; weekday++) {
+            uint64_t before = hoursOf[doctor][weekday], after = doctors[doctor].getWorkingHours(weekday);
+            for (int slot = 0; slot < SLOTS_PER_DAY; slot++) {
+                group.working[weekday][slot] += int((after >> slot) & 1) - int((before >> slot) & 1);
+            }
+            hoursOf[doctor][weekday] = after;
+        }
+        refresh(doctors, doctor, group.cursor);
+    }
+
+    void onBooked(const vector<Doctor>& doctors, int doctor, int slot) {
+        countBooking(doctor, slot, 1);
+        if (slot == queuedKey[doctor] && !searchedTo[doctor]) refresh(doctors, doctor, slot + 1);
+    }
+
+    void onReleased(const vector<Doctor>& doctors, int doctor, int slot) {
+        countBooking(doctor, slot, -1);
+        if (slot >= groups[groupOf[doctor]].cursor && slot < queuedKey[doctor]) refresh(doctors, doctor, slot);
+    }
+
+    // Earliest (slot, doctor) at or after fromSlot in the group, {-1, -1} if
+    // nothing is free within HORIZON_DAYS
+    pair<int, int> earliest(const vector<Doctor>& doctors, int group, int fromSlot) {
+        Group& g = groups[group];
+        int limit = horizonEnd(fromSlot);
+        if (fromSlot < g.cursor) {
+            pair<int, int> before = earliestByCounts(doctors, g, fromSlot, min(g.cursor, limit));
+            return before.first >= 0 ? before : settle(doctors, g, g.cursor, limit);
+        }
+        g.cursor = fromSlot;
+        return settle(doctors, g, fromSlot, limit);
+    }
+};
+
+// Drug and allergen names that appear in interaction rules, interned into
+// dense term ids, with two conflict bit matrices over those terms only, so
+// free-text entries that no rule mentions never take up a row: one from each
+// drug to the allergens it must not meet, and a symmetric one between drugs.
+// Rules come from a local file where each line is one of
+//     ALLERGY|<allergen>|<drug>
+//     DRUG|<drug>|<drug>
+// and blank lines or lines starting with '#' are ignored. Names compare
+// case-insensitively.
+class InteractionChecker {
+private:
+    unordered_map<string, uint32_t> ids;
+    vector<string> names;
+    vector<pair<uint32_t, uint32_t>> allergyRules;  // (allergen, drug)
+    vector<pair<uint32_t, uint32_t>> drugRules;     // (drug, drug)
+    vector<vector<uint64_t>> allergyBits;  // drug -> allergens it conflicts with
+    vector<vector<uint64_t>> drugBits;     // drug -> drugs it conflicts with
+
+    uint32_t intern(const string& name) {
+        string key = normalize(name);
+        auto it = ids.find(key);
+        if (it != ids.end()) return it->second;
+        ids.emplace(key, names.size());
+        names.push_back(name);
+        return names.size() - 1;
+    }
+
+    static void setBit(vector<vector<uint64_t>>& matrix, uint32_t row, uint32_t column) {
+        matrix[row][column / 64] |= 1ULL << (column % 64);
+    }
+
+    // Rows are sized with headroom so rules added one at a time rarely rebuild
+    void buildMatrices() {
+        size_t rows = names.size() + names.size() / 2 + 64;
+        size_t words = (rows + 63) / 64;
+        allergyBits.assign(rows, vector<uint64_t>(words, 0));
+        drugBits.assign(rows, vector<uint64_t>(words, 0));
+        for (const auto& rule : allergyRules) setBit(allergyBits, rule.second, rule.first);
+        for (const auto& rule : drugRules) {
+            setBit(drugBits, rule.first, rule.second);
+            setBit(drugBits, rule.second, rule.first);
+        }
+    }
+
+    void addRule(bool allergy, const string& a, const string& b) {
+        uint32_t first = intern(a), second = intern(b);
+        (allergy ? allergyRules : drugRules).push_back({first, second});
+        if (names.size() > allergyBits.size()) {
+            buildMatrices();
+        } else if (allergy) {
+            setBit(allergyBits, second, first);
+        } else {
+            setBit(drugBits, first, second);
+            setBit(drugBits, second, first);
+        }
+    }
+
+public:
+    static string normalize(const string& name) {
+        size_t first = name.find_first_not_of(" \t"), last = name.find_last_not_of(" \t\r");
+        if (first == string::npos) return "";
+        string result = name.substr(first, last - first + 1);
+        for (char& c : result) c = tolower(c);
+        return result;
+    }
+
+    // Term of a name, -1 if no rule mentions it
+    int find(const string& name) const {
+        auto it = ids.find(normalize(name));
+        return it == ids.end() ? -1 : int(it->second);
+    }
+
+    const string& nameOf(uint32_t term) const { return names[term]; }
+    size_t termCount() const { return names.size(); }
+
+    // Bitsets of the allergen and drug terms that conflict with a drug term;
+    // both matrices have the same shape
+    const vector<uint64_t>& allergyConflictsOf(uint32_t drug) const { return allergyBits[drug]; }
+    const vector<uint64_t>& drugConflictsOf(uint32_t drug) const { return drugBits[drug]; }
+
+    // New terms get the next ids, so callers can spot them through termCount()
+    void addAllergyRule(const string& allergen, const string& drug) { addRule(true, allergen, drug); }
+    void addDrugRule(const string& a, const string& b) { addRule(false, a, b); }
+
+    // Replaces all rules and renumbers the terms; returns false if the file cannot be read
+    bool loadRules(const string& path) {
+        ifstream file(path);
+        if (!file) return false;
+        ids.clear();
+        names.clear();
+        allergyRules.clear();
+        drugRules.clear();
+        string line;
+        while (getline(file, line)) {
+            if (line.empty() || line[0] == '#') continue;
+            size_t first = line.find('|'), second = line.find('|', first + 1);
+            if (first == string::npos || second == string::npos) continue;
+            string kind = normalize(line.substr(0, first));
+            if (kind != "allergy" && kind != "drug") continue;
+            (kind == "allergy" ? allergyRules : drugRules).push_back(
+                {intern(line.substr(first + 1, second - first - 1)), intern(line.substr(second + 1))});
+        }
+        buildMatrices();
+        return true;
+    }
+
+    size_t ruleCount() const { return allergyRules.size() + drugRules.size(); }
+};
+
+// A patient's allergies and current medications as bitsets over rule terms
+struct PatientSubstances {
+    vector<uint64_t> allergies;
+    vector<uint64_t> medications;
+
+    static void set(vector<uint64_t>& bits, uint32_t term) {
+        if (term / 64 >= bits.size()) bits.resize(term / 64 + 1, 0);
+        bits[term / 64] |= 1ULL << (term % 64);
+    }
+
+    static uint64_t word(const vector<uint64_t>& bits, size_t w) { return w < bits.size() ? bits[w] : 0; }
+
+    static void terms(const vector<uint64_t>& bits, vector<uint32_t>& out) {
+        out.clear();
+        for (size_t w = 0; w < bits.size(); w++) {
+            for (uint64_t word = bits[w]; word; word &= word - 1) out.push_back(w * 64 + __builtin_ctzll(word));
+        }
+    }
+};
+
+// One entry of a batch scheduling queue: any doctor of the specialization,
+// any free slot on date inside the "HH:MM-HH:MM" window
+struct AppointmentRequest {
+    string patientId;
+    string specialization;
+    string date;
+    string window;
+};
+
 class HospitalManagementSystem {
 private:
     vector<Patient> patients;
@@ -174,15 +803,270 @@ private:
     vector<Appointment> appointments;
     map<string, int> patientIndex;    // patientId -> index
     map<string, int> doctorIndex;     // doctorId -> index
+    unordered_map<string, size_t> appointmentIndex;  // appointmentId -> index
+
+    // Secondary indexes over appointment positions. Cancelled appointments leave
+    // the doctor-day and day lists (clinic lists) but stay in patient histories.
+    unordered_map<uint64_t, vector<size_t>> appointmentsByDoctorDay;
+    unordered_map<int, vector<size_t>> appointmentsByDay;
+    unordered_map<string, vector<size_t>> appointmentsByPatient;
+    vector<size_t> dayListPosition;  // appointment -> position in its day list
+    ClinicalHistoryStore clinicalHistory;
+    InteractionChecker interactions;
+    vector<PatientSubstances> substances;  // parallel to patients
+
+    // Every allergy and medication entered, by normalized name, so a name
+    // that later appears in a rule can be marked on the patients who have it
+    unordered_map<string, vector<pair<int, bool>>> substanceHolders;  // -> (patient, is allergy)
+
+    void markSubstance(int patient, bool allergy, uint32_t term) {
+        PatientSubstances& profile = substances[patient];
+        PatientSubstances::set(allergy ? profile.allergies : profile.medications, term);
+    }
+
+    void recordSubstance(int patient, bool allergy, const string& name) {
+        substanceHolders[InteractionChecker::normalize(name)].push_back({patient, allergy});
+        int term = interactions.find(name);
+        if (term >= 0) markSubstance(patient, allergy, term);
+    }
+
+    // Marks patients holding terms [firstTerm, termCount()) that a new rule introduced
+    void markNewTerms(size_t firstTerm) {
+        for (size_t term = firstTerm; term < interactions.termCount(); term++) {
+            auto it = substanceHolders.find(InteractionChecker::normalize(interactions.nameOf(term)));
+            if (it == substanceHolders.end()) continue;
+            for (const auto& holder : it->second) markSubstance(holder.first, holder.second, term);
+        }
+    }
+
+    // Term ids change when the rules are replaced
+    void rebuildSubstanceBits() {
+        for (PatientSubstances& profile : substances) profile = PatientSubstances();
+        for (const auto& entry : substanceHolders) {
+            int term = interactions.find(entry.first);
+            if (term < 0) continue;
+            for (const auto& holder : entry.second) markSubstance(holder.first, holder.second, term);
+        }
+    }
+    EarliestSlotIndex earliestSlots;
+    AttributeTable bloodGroups;
+    AttributeTable specializations;
     int lastAppointmentNumber;
 
     string generateAppointmentId() {
         return "APP" + to_string(++lastAppointmentNumber);
     }
 
+    static uint64_t doctorDayKey(int doctor, int day) {
+        return (uint64_t(uint32_t(doctor)) << 32) | uint32_t(day);
+    }
+
+    void indexAppointment(size_t pos, int doctor, int day) {
+        appointmentsByDoctorDay[doctorDayKey(doctor, day)].push_back(pos);
+        vector<size_t>& dayList = appointmentsByDay[day];
+        dayListPosition.push_back(dayList.size());
+        dayList.push_back(pos);
+        appointmentsByPatient[appointments[pos].getPatientId()].push_back(pos);
+    }
+
+    // Removes a cancelled appointment from the clinic lists; a doctor's day holds
+    // at most SLOTS_PER_DAY entries and the day list swap-removes in O(1)
+    void unindexFromClinicLists(size_t pos, int doctor, int day) {
+        vector<size_t>& doctorDay = appointmentsByDoctorDay[doctorDayKey(doctor, day)];
+        doctorDay.erase(find(doctorDay.begin(), doctorDay.end(), pos));
+
+        vector<size_t>& dayList = appointmentsByDay[day];
+        size_t last = dayList.back();
+        dayList[dayListPosition[pos]] = last;
+        dayListPosition[last] = dayListPosition[pos];
+        dayList.pop_back();
+    }
+
+    vector<const Appointment*> sortedByTime(const vector<size_t>* positions) const {
+        vector<const Appointment*> result;
+        if (positions == nullptr) return result;
+        // Parse each date and time once, not on every comparison
+        vector<pair<int64_t, size_t>> keyed;
+        keyed.reserve(positions->size());
+        for (size_t pos : *positions) {
+            const Appointment& appointment = appointments[pos];
+            keyed.push_back({int64_t(parseDayNumber(appointment.getDate())) * 24 * 60 +
+                             parseMinutes(appointment.getTimeSlot()), pos});
+        }
+        sort(keyed.begin(), keyed.end(), [](const pair<int64_t, size_t>& a, const pair<int64_t, size_t>& b) {
+            return a.first < b.first;
+        });
+        result.reserve(keyed.size());
+        for (const auto& entry : keyed) result.push_back(&appointments[entry.second]);
+        return result;
+    }
+
 public:
     HospitalManagementSystem() : lastAppointmentNumber(1000) {}
 
+    // Adds a patient without prompting; returns false if the ID is taken
+    bool addPatient(const string& id, const string& name, int age, const string& gender,
+                    const string& phone, const string& address, const string& bloodGroup) {
+        int bloodGroupId = bloodGroups.intern(bloodGroup);
+        if (patientIndex.find(id) != patientIndex.end() || bloodGroupId < 0) {
+            return false;
+        }
+        patients.emplace_back(id, name, age, gender, phone, address, bloodGroupId,
+                              clinicalHistory.createHistory());
+        patientIndex[id] = patients.size() - 1;
+        substances.emplace_back();
+        return true;
+    }
+
+    // Whether the medication is itself one of the patient's recorded allergies,
+    // whether or not any rule names it
+    bool isAllergicTo(int patient, const string& medication) const {
+        auto it = substanceHolders.find(InteractionChecker::normalize(medication));
+        if (it == substanceHolders.end()) return false;
+        for (const auto& holder : it->second) {
+            if (holder.first == patient && holder.second) return true;
+        }
+        return false;
+    }
+
+    // Terms in the patient's allergies and current medications that conflict
+    // with the medication: its allergy row ANDed with the patient's allergies
+    // and its drug row with the patient's medications, whatever the number of
+    // entries on record
+    vector<uint32_t> checkPrescription(int patient, const string& medication) const {
+        vector<uint32_t> found;
+        int drug = interactions.find(medication);
+        if (drug < 0) return found;
+        const vector<uint64_t>& allergyRow = interactions.allergyConflictsOf(drug);
+        const vector<uint64_t>& drugRow = interactions.drugConflictsOf(drug);
+        const PatientSubstances& profile = substances[patient];
+        size_t words = min(allergyRow.size(), max(profile.allergies.size(), profile.medications.size()));
+        for (size_t w = 0; w < words; w++) {
+            uint64_t hits = (allergyRow[w] & PatientSubstances::word(profile.allergies, w)) |
+                            (drugRow[w] & PatientSubstances::word(profile.medications, w));
+            for (; hits; hits &= hits - 1) found.push_back(w * 64 + __builtin_ctzll(hits));
+        }
+        return found;
+    }
+
+    void recordMedication(int patient, const string& medication) {
+        clinicalHistory.append(patients[patient].getHistoryHandle(), ClinicalEntryType::Medication, medication);
+        recordSubstance(patient, false, medication);
+    }
+
+    void recordAllergy(int patient, const string& allergy) {
+        clinicalHistory.append(patients[patient].getHistoryHandle(), ClinicalEntryType::Allergy, allergy);
+        recordSubstance(patient, true, allergy);
+    }
+
+    // Prescribes without prompting; returns false and leaves the record
+    // untouched if the medication conflicts, unless override is set
+    bool prescribe(const string& patientId, const string& medication, bool overrideConflicts = false) {
+        auto it = patientIndex.find(patientId);
+        if (it == patientIndex.end()) return false;
+        if (!overrideConflicts && (isAllergicTo(it->second, medication) ||
+                                   !checkPrescription(it->second, medication).empty())) {
+            return false;
+        }
+        recordMedication(it->second, medication);
+        return true;
+    }
+
+    bool addAllergy(const string& patientId, const string& allergy) {
+        auto it = patientIndex.find(patientId);
+        if (it == patientIndex.end()) return false;
+        recordAllergy(it->second, allergy);
+        return true;
+    }
+
+    // Batch mode: every (patient, medication, conflicting term) under the current rules
+    vector<pair<int, pair<uint32_t, uint32_t>>> recheckAllPatients() const {
+        vector<pair<int, pair<uint32_t, uint32_t>>> found;
+        vector<uint32_t> allergies, medications;
+        for (int p = 0; p < (int)substances.size(); p++) {
+            const PatientSubstances& profile = substances[p];
+            PatientSubstances::terms(profile.allergies, allergies);
+            PatientSubstances::terms(profile.medications, medications);
+            for (size_t i = 0; i < medications.size(); i++) {
+                const vector<uint64_t>& allergyRow = interactions.allergyConflictsOf(medications[i]);
+                const vector<uint64_t>& drugRow = interactions.drugConflictsOf(medications[i]);
+                auto has = [](const vector<uint64_t>& row, uint32_t term) { return (row[term / 64] >> (term % 64)) & 1; };
+                for (uint32_t allergy : allergies) {
+                    if (has(allergyRow, allergy)) found.push_back({p, {medications[i], allergy}});
+                }
+                for (size_t j = i + 1; j < medications.size(); j++) {
+                    if (has(drugRow, medications[j])) found.push_back({p, {medications[i], medications[j]}});
+                }
+            }
+        }
+        return found;
+    }
+
+    bool loadInteractionRules(const string& path) {
+        if (!interactions.loadRules(path)) return false;
+        rebuildSubstanceBits();
+        return true;
+    }
+
+    void addAllergyRule(const string& allergen, const string& drug) {
+        size_t before = interactions.termCount();
+        interactions.addAllergyRule(allergen, drug);
+        markNewTerms(before);
+    }
+
+    void addDrugRule(const string& a, const string& b) {
+        size_t before = interactions.termCount();
+        interactions.addDrugRule(a, b);
+        markNewTerms(before);
+    }
+
+    void loadInteractionRules() {
+        string path;
+        cin.ignore();
+        cout << "\nEnter Rules File Path: ";
+        getline(cin, path);
+
+        if (!loadInteractionRules(path)) {
+            cout << "Error: Could not read rules file!" << endl;
+            return;
+        }
+        cout << "\n" << interactions.ruleCount() << " interaction rule(s) loaded." << endl;
+
+        auto found = recheckAllPatients();
+        if (found.empty()) {
+            cout << "No existing prescriptions conflict with the new rules." << endl;
+            return;
+        }
+        cout << "Existing prescriptions that now conflict:" << endl;
+        for (const auto& conflict : found) {
+            cout << "- " << patients[conflict.first].getId() << ": "
+                 << interactions.nameOf(conflict.second.first) << " with "
+                 << interactions.nameOf(conflict.second.second) << endl;
+        }
+    }
+
+    // Adds a doctor without prompting; working hours follow through addDoctorSchedule
+    bool addDoctor(const string& id, const string& name, const string& specialization,
+                   const string& phone, const string& email, double fee) {
+        int specializationId = specializations.intern(specialization);
+        if (doctorIndex.find(id) != doctorIndex.end() || specializationId < 0) {
+            return false;
+        }
+        doctors.emplace_back(id, name, specializationId, phone, email, fee);
+        doctorIndex[id] = doctors.size() - 1;
+        earliestSlots.addDoctor(doctors, doctors.size() - 1);
+        return true;
+    }
+
+    bool addDoctorSchedule(const string& doctorId, const string& day, const string& timeSlot) {
+        auto it = doctorIndex.find(doctorId);
+        if (it == doctorIndex.end() || !doctors[it->second].addSchedule(day, timeSlot)) {
+            return false;
+        }
+        earliestSlots.onScheduleChanged(doctors, it->second);
+        return true;
+    }
+
     void addPatient() {
         string id, name, gender, phone, address, bloodGroup;
         int age;
@@ -211,8 +1095,10 @@ public:
         cout << "Blood Group: ";
         getline(cin, bloodGroup);
 
-        patients.emplace_back(id, name, age, gender, phone, address, bloodGroup);
-        patientIndex[id] = patients.size() - 1;
+        if (!addPatient(id, name, age, gender, phone, address, bloodGroup)) {
+            cout << "Error: Too many distinct blood groups!" << endl;
+            return;
+        }
         cout << "\nPatient added successfully!" << endl;
     }
 
@@ -241,8 +1127,10 @@ public:
         cout << "Consultation Fee (ETB): ";
         cin >> fee;
 
-        doctors.emplace_back(id, name, specialization, phone, email, fee);
-        doctorIndex[id] = doctors.size() - 1;
+        if (!addDoctor(id, name, specialization, phone, email, fee)) {
+            cout << "Error: Too many distinct specializations!" << endl;
+            return;
+        }
 
         // Add schedule
         string day, timeSlot;
@@ -250,11 +1138,13 @@ public:
         cin.ignore();
         do {
             cout << "\nAdd Schedule" << endl;
-            cout << "Day: ";
+            cout << "Day (e.g. Monday): ";
             getline(cin, day);
-            cout << "Time Slot: ";
+            cout << "Time Slot (HH:MM-HH:MM): ";
             getline(cin, timeSlot);
-            doctors.back().addSchedule(day, timeSlot);
+            if (!addDoctorSchedule(id, day, timeSlot)) {
+                cout << "Error: Invalid day or time slot!" << endl;
+            }
 
             cout << "Add more schedule? (Y/N): ";
             cin >> addMore;
@@ -264,6 +1154,27 @@ public:
         cout << "\nDoctor added successfully!" << endl;
     }
 
+    // Books the slot containing timeSlot ("HH:MM") on date without prompting;
+    // returns the appointment ID or "" if anything is unknown or the slot is taken
+    string scheduleAppointment(const string& patientId, const string& doctorId,
+                               const string& date, const string& timeSlot) {
+        auto doctorIt = doctorIndex.find(doctorId);
+        int day = parseDayNumber(date);
+        int minutes = parseMinutes(timeSlot);
+        if (patientIndex.find(patientId) == patientIndex.end() || doctorIt == doctorIndex.end() ||
+            day < 0 || minutes < 0 || !doctors[doctorIt->second].bookSlot(day, minutes / SLOT_MINUTES)) {
+            return "";
+        }
+        earliestSlots.onBooked(doctors, doctorIt->second, day * SLOTS_PER_DAY + minutes / SLOT_MINUTES);
+
+        string appointmentId = generateAppointmentId();
+        appointments.emplace_back(appointmentId, patientId, doctorId, date, timeSlot);
+        appointments.back().confirm();
+        appointmentIndex[appointmentId] = appointments.size() - 1;
+        indexAppointment(appointments.size() - 1, doctorIt->second, day);
+        return appointmentId;
+    }
+
     void scheduleAppointment() {
         string patientId, doctorId, date, timeSlot;
 
@@ -289,23 +1200,270 @@ public:
         cin.ignore();
         cout << "Date (DD/MM/YYYY): ";
         getline(cin, date);
-        cout << "Time Slot: ";
+        cout << "Time Slot (HH:MM): ";
         getline(cin, timeSlot);
 
-        const Doctor& doctor = doctors[doctorIt->second];
-        if (!doctor.isAvailable(date, timeSlot)) {
+        string appointmentId = scheduleAppointment(patientId, doctorId, date, timeSlot);
+        if (appointmentId.empty()) {
             cout << "Error: Doctor not available at specified time!" << endl;
             return;
         }
 
-        string appointmentId = generateAppointmentId();
-        appointments.emplace_back(appointmentId, patientId, doctorId, date, timeSlot);
-        appointments.back().confirm();
-
         cout << "\nAppointment scheduled successfully!" << endl;
         cout << "Appointment ID: " << appointmentId << endl;
     }
 
+    // Assigns a queue of requests to free slots and books them; returns the
+    // appointment ID for each request, "" where nothing fitted. Doctors belong
+    // to exactly one specialization, so each specialization is planned on its
+    // own worker against a private copy of its doctors' free slots, placing the
+    // narrowest windows first. Plans are then booked in queue order.
+    vector<string> scheduleBatch(const vector<AppointmentRequest>& requests,
+                                 int threadCount = thread::hardware_concurrency()) {
+        struct Parsed { int day; uint64_t window; };
+        vector<Parsed> parsed(requests.size());
+        vector<vector<int>> byGroup;
+        for (size_t i = 0; i < requests.size(); i++) {
+            const AppointmentRequest& request = requests[i];
+            int group = earliestSlots.findSpecialization(specializations, request.specialization);
+            parsed[i] = {parseDayNumber(request.date), parseSlotRange(request.window)};
+            if (group < 0 || parsed[i].day < 0 || parsed[i].window == 0 ||
+                patientIndex.find(request.patientId) == patientIndex.end()) {
+                continue;
+            }
+            if (group >= int(byGroup.size())) byGroup.resize(group + 1);
+            byGroup[group].push_back(i);
+        }
+
+        vector<int> plannedDoctor(requests.size(), -1), plannedSlot(requests.size(), -1);
+        atomic<size_t> nextGroup(0);
+        auto planGroups = [&]() {
+            for (size_t group; (group = nextGroup++) < byGroup.size();) {
+                vector<int>& queue = byGroup[group];
+                sort(queue.begin(), queue.end(), [&](int a, int b) {
+                    if (parsed[a].day != parsed[b].day) return parsed[a].day < parsed[b].day;
+                    int widthA = __builtin_popcountll(parsed[a].window);
+                    int widthB = __builtin_popcountll(parsed[b].window);
+                    if (widthA != widthB) return widthA < widthB;
+                    return a < b;
+                });
+
+                const vector<int>& members = earliestSlots.doctorsIn(group);
+                vector<uint64_t> freeSlots;
+                int loadedDay = -1;
+                for (int i : queue) {
+                    if (parsed[i].day != loadedDay) {
+                        loadedDay = parsed[i].day;
+                        freeSlots.clear();
+                        for (int doctor : members) freeSlots.push_back(doctors[doctor].getFreeSlots(loadedDay));
+                    }
+                    int best = -1, bestSlot = SLOTS_PER_DAY;
+                    for (size_t k = 0; k < members.size() && bestSlot > 0; k++) {
+                        uint64_t fits = freeSlots[k] & parsed[i].window;
+                        if (fits && __builtin_ctzll(fits) < bestSlot) {
+                            best = k;
+                            bestSlot = __builtin_ctzll(fits);
+                        }
+                    }
+                    if (best < 0) continue;
+                    freeSlots[best] &= ~(1ULL << bestSlot);
+                    plannedDoctor[i] = members[best];
+                    plannedSlot[i] = bestSlot;
+                }
+            }
+        };
+
+        vector<thread> workers;
+        for (int t = 1; t < threadCount; t++) workers.emplace_back(planGroups);
+        planGroups();
+        for (thread& worker : workers) worker.join();
+
+        vector<string> appointmentIds(requests.size());
+        for (size_t i = 0; i < requests.size(); i++) {
+            if (plannedDoctor[i] < 0) continue;
+            appointmentIds[i] = scheduleAppointment(requests[i].patientId, doctors[plannedDoctor[i]].getId(),
+                                                    requests[i].date, formatSlot(plannedSlot[i]));
+        }
+        return appointmentIds;
+    }
+
+    // Reads "patientId|specialization|DD/MM/YYYY|HH:MM-HH:MM" lines and books them as one batch
+    void scheduleBatchFromFile() {
+        string path;
+        cin.ignore();
+        cout << "\nEnter Requests File Path: ";
+        getline(cin, path);
+
+        ifstream file(path);
+        if (!file) {
+            cout << "Error: Could not read requests file!" << endl;
+            return;
+        }
+        vector<AppointmentRequest> requests;
+        string line;
+        while (getline(file, line)) {
+            if (line.empty() || line[0] == '#') continue;
+            AppointmentRequest request;
+            size_t a = line.find('|'), b = line.find('|', a + 1), c = line.find('|', b + 1);
+            if (c == string::npos) continue;
+            request.patientId = line.substr(0, a);
+            request.specialization = line.substr(a + 1, b - a - 1);
+            request.date = line.substr(b + 1, c - b - 1);
+            request.window = line.substr(c + 1);
+            requests.push_back(request);
+        }
+
+        vector<string> appointmentIds = scheduleBatch(requests);
+        size_t filled = 0;
+        cout << endl;
+        for (size_t i = 0; i < requests.size(); i++) {
+            if (appointmentIds[i].empty()) {
+                cout << requests[i].patientId << ": no free slot in " << requests[i].window << endl;
+                continue;
+            }
+            const Appointment& appointment = appointments[appointmentIndex[appointmentIds[i]]];
+            cout << requests[i].patientId << ": " << appointmentIds[i] << " at " << appointment.getTimeSlot()
+                 << " with " << appointment.getDoctorId() << endl;
+            filled++;
+        }
+        cout << "\n" << filled << " of " << requests.size() << " request(s) scheduled." << endl;
+    }
+
+    // Cancels a scheduled appointment and frees the doctor's slot
+    bool cancelAppointment(const string& appointmentId) {
+        auto it = appointmentIndex.find(appointmentId);
+        if (it == appointmentIndex.end() || appointments[it->second].getStatus() != AppointmentStatus::Scheduled) {
+            return false;
+        }
+        Appointment& appointment = appointments[it->second];
+        int doctor = doctorIndex.at(appointment.getDoctorId());
+        int day = parseDayNumber(appointment.getDate());
+        int slot = parseMinutes(appointment.getTimeSlot()) / SLOT_MINUTES;
+        doctors[doctor].releaseSlot(day, slot);
+        earliestSlots.onReleased(doctors, doctor, day * SLOTS_PER_DAY + slot);
+        appointment.cancel();
+        unindexFromClinicLists(it->second, doctor, day);
+        return true;
+    }
+
+    bool completeAppointment(const string& appointmentId, const string& notes) {
+        auto it = appointmentIndex.find(appointmentId);
+        if (it == appointmentIndex.end() || appointments[it->second].getStatus() != AppointmentStatus::Scheduled) {
+            return false;
+        }
+        appointments[it->second].complete();
+        appointments[it->second].addNotes(notes);
+        return true;
+    }
+
+    void completeAppointment() {
+        string appointmentId, notes;
+        cout << "\nEnter Appointment ID: ";
+        cin >> appointmentId;
+        cin.ignore();
+        cout << "Doctor's Notes: ";
+        getline(cin, notes);
+
+        if (!completeAppointment(appointmentId, notes)) {
+            cout << "Error: Appointment not found or not scheduled!" << endl;
+            return;
+        }
+        cout << "\nAppointment completed successfully!" << endl;
+    }
+
+    // Clinic list of one doctor for one day, in time order
+    vector<const Appointment*> getDoctorDayAppointments(const string& doctorId, const string& date) const {
+        auto doctorIt = doctorIndex.find(doctorId);
+        if (doctorIt == doctorIndex.end()) return {};
+        auto it = appointmentsByDoctorDay.find(doctorDayKey(doctorIt->second, parseDayNumber(date)));
+        return sortedByTime(it == appointmentsByDoctorDay.end() ? nullptr : &it->second);
+    }
+
+    vector<const Appointment*> getDayAppointments(const string& date) const {
+        auto it = appointmentsByDay.find(parseDayNumber(date));
+        return sortedByTime(it == appointmentsByDay.end() ? nullptr : &it->second);
+    }
+
+    // Full history of a patient, cancelled appointments included
+    vector<const Appointment*> getPatientAppointments(const string& patientId) const {
+        auto it = appointmentsByPatient.find(patientId);
+        return sortedByTime(it == appointmentsByPatient.end() ? nullptr : &it->second);
+    }
+
+    void displayAppointmentLists() const {
+        int choice;
+        string key, date;
+        cout << "\n1. Doctor's Day" << endl;
+        cout << "2. Patient History" << endl;
+        cout << "3. Daily Clinic List" << endl;
+        cout << "Enter your choice: ";
+        cin >> choice;
+
+        vector<const Appointment*> list;
+        if (choice == 1) {
+            cout << "Enter Doctor ID: ";
+            cin >> key;
+            cout << "Enter Date (DD/MM/YYYY): ";
+            cin >> date;
+            list = getDoctorDayAppointments(key, date);
+        } else if (choice == 2) {
+            cout << "Enter Patient ID: ";
+            cin >> key;
+            list = getPatientAppointments(key);
+        } else if (choice == 3) {
+            cout << "Enter Date (DD/MM/YYYY): ";
+            cin >> date;
+            list = getDayAppointments(date);
+        } else {
+            cout << "\nInvalid choice!" << endl;
+            return;
+        }
+
+        if (list.empty()) {
+            cout << "\nNo appointments found." << endl;
+            return;
+        }
+        for (const Appointment* appointment : list) {
+            appointment->displayInfo();
+        }
+    }
+
+    void cancelAppointment() {
+        string appointmentId;
+        cout << "\nEnter Appointment ID: ";
+        cin >> appointmentId;
+
+        if (!cancelAppointment(appointmentId)) {
+            cout << "Error: Appointment not found or not scheduled!" << endl;
+            return;
+        }
+        cout << "\nAppointment cancelled successfully!" << endl;
+    }
+
+    void displayFreeSlots() {
+        string doctorId, date;
+        cout << "\nEnter Doctor ID: ";
+        cin >> doctorId;
+        cout << "Enter Date (DD/MM/YYYY): ";
+        cin >> date;
+
+        auto doctorIt = doctorIndex.find(doctorId);
+        int day = parseDayNumber(date);
+        if (doctorIt == doctorIndex.end() || day < 0) {
+            cout << "Error: Doctor not found or invalid date!" << endl;
+            return;
+        }
+
+        const Doctor& doctor = doctors[doctorIt->second];
+        uint64_t free = doctor.getFreeSlots(day);
+        cout << "\nFree slots on " << date << ":";
+        if (free == 0) cout << " none";
+        for (int slot = 0; slot < SLOTS_PER_DAY; slot++) {
+            if ((free >> slot) & 1) cout << " " << formatSlot(slot);
+        }
+        cout << "\nFree slots this week: " << doctor.getFreeSlotsInWeek(day) << endl;
+    }
+
     void updateMedicalHistory() {
         string patientId;
         cout << "\nEnter Patient ID: ";
@@ -325,7 +1483,7 @@ public:
         do {
             cout << "Enter medical condition: ";
             getline(cin, condition);
-            patient.addMedicalHistory(condition);
+            clinicalHistory.append(patient.getHistoryHandle(), ClinicalEntryType::Condition, condition);
 
             cout << "Add more conditions? (Y/N): ";
             cin >> addMore;
@@ -346,7 +1504,6 @@ public:
             return;
         }
 
-        Patient& patient = patients[patientIt->second];
         string medication;
         char addMore;
 
@@ -354,7 +1511,22 @@ public:
         do {
             cout << "Enter medication: ";
             getline(cin, medication);
-            patient.addMedication(medication);
+
+            vector<uint32_t> found = checkPrescription(patientIt->second, medication);
+            bool allergic = isAllergicTo(patientIt->second, medication);
+            char prescribeAnyway = 'Y';
+            if (allergic) cout << "Warning: Patient is allergic to " << medication << "!" << endl;
+            for (uint32_t term : found) {
+                cout << "Warning: " << medication << " conflicts with " << interactions.nameOf(term) << "!" << endl;
+            }
+            if (allergic || !found.empty()) {
+                cout << "Prescribe anyway? (Y/N): ";
+                cin >> prescribeAnyway;
+                cin.ignore();
+            }
+            if (toupper(prescribeAnyway) == 'Y') {
+                recordMedication(patientIt->second, medication);
+            }
 
             cout << "Add more medications? (Y/N): ";
             cin >> addMore;
@@ -364,6 +1536,34 @@ public:
         cout << "\nMedications updated successfully!" << endl;
     }
 
+    void updateAllergies() {
+        string patientId;
+        cout << "\nEnter Patient ID: ";
+        cin >> patientId;
+
+        auto patientIt = patientIndex.find(patientId);
+        if (patientIt == patientIndex.end()) {
+            cout << "Error: Patient not found!" << endl;
+            return;
+        }
+
+        string allergy;
+        char addMore;
+
+        cin.ignore();
+        do {
+            cout << "Enter allergy: ";
+            getline(cin, allergy);
+            recordAllergy(patientIt->second, allergy);
+
+            cout << "Add more allergies? (Y/N): ";
+            cin >> addMore;
+            cin.ignore();
+        } while (toupper(addMore) == 'Y');
+
+        cout << "\nAllergies updated successfully!" << endl;
+    }
+
     void displayPatientInfo() {
         string patientId;
         cout << "\nEnter Patient ID: ";
@@ -375,7 +1575,7 @@ public:
             return;
         }
 
-        patients[patientIt->second].displayInfo();
+        patients[patientIt->second].displayInfo(clinicalHistory, bloodGroups);
     }
 
     void displayDoctorInfo() {
@@ -389,7 +1589,7 @@ public:
             return;
         }
 
-        doctors[doctorIt->second].displayInfo();
+        doctors[doctorIt->second].displayInfo(specializations);
     }
 
     void displayAppointments() const {
@@ -410,20 +1610,580 @@ public:
         cout << "\nEnter Specialization: ";
         getline(cin, specialization);
 
-        bool found = false;
-        for (const auto& doctor : doctors) {
-            if (doctor.getSpecialization() == specialization) {
-                doctor.displayInfo();
-                found = true;
-            }
+        int group = earliestSlots.findSpecialization(specializations, specialization);
+        if (group < 0) {
+            cout << "\nNo doctors found for the specified specialization." << endl;
+            return;
+        }
+        for (int doctor : earliestSlots.doctorsIn(group)) {
+            doctors[doctor].displayInfo(specializations);
         }
+    }
 
-        if (!found) {
-            cout << "\nNo doctors found for the specified specialization." << endl;
+    // Earliest free (slot, doctor index) for the specialization at or after
+    // date + time; {-1, -1} if nothing is free within a year
+    pair<int, int> findEarliestSlot(const string& specialization, const string& date,
+                                    const string& time) {
+        int group = earliestSlots.findSpecialization(specializations, specialization);
+        int day = parseDayNumber(date), minutes = parseMinutes(time);
+        if (group < 0 || day < 0 || minutes < 0) return {-1, -1};
+        return earliestSlots.earliest(doctors, group, day * SLOTS_PER_DAY + minutes / SLOT_MINUTES);
+    }
+
+    // The same answer found by checking every doctor, kept for benchmarking
+    pair<int, int> scanEarliestSlot(const string& specialization, int fromSlot) const {
+        pair<int, int> best(-1, -1);
+        int wanted = specializations.find(specialization);
+        for (size_t d = 0; d < doctors.size(); d++) {
+            if (doctors[d].getSpecializationId() != wanted) continue;
+            int slot = doctors[d].getNextFreeSlot(fromSlot, 366);
+            if (slot >= 0 && (best.first < 0 || make_pair(slot, int(d)) < best)) best = {slot, int(d)};
+        }
+        return best;
+    }
+
+    void findEarliestAppointment() {
+        string specialization, date, time;
+        cin.ignore();
+        cout << "\nEnter Specialization: ";
+        getline(cin, specialization);
+        cout << "Enter Date (DD/MM/YYYY): ";
+        getline(cin, date);
+        cout << "Enter Time (HH:MM): ";
+        getline(cin, time);
+
+        pair<int, int> earliest = findEarliestSlot(specialization, date, time);
+        if (earliest.first < 0) {
+            cout << "\nNo free slot found for the specified specialization." << endl;
+            return;
+        }
+        int day = earliest.first / SLOTS_PER_DAY;
+        int offset = day - parseDayNumber(date);
+        cout << "\nEarliest slot: " << formatSlot(earliest.first % SLOTS_PER_DAY);
+        if (offset > 0) cout << " (" << offset << " day(s) after " << date << ")";
+        else cout << " on " << date;
+        cout << " with " << doctors[earliest.second].getName()
+             << " (ID: " << doctors[earliest.second].getId() << ")" << endl;
+    }
+
+    string getDoctorId(int doctor) const { return doctors[doctor].getId(); }
+};
+
+// Benchmark helper: nanoseconds per operation over a batch
+double nanosPerOp(chrono::steady_clock::time_point start, size_t operations) {
+    return chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() /
+           max<size_t>(1, operations);
+}
+
+void runCalendarBenchmark() {
+    const int doctorCount = 5000;
+    const int days = 365;
+    const int firstDay = parseDayNumber("01/01/2026");
+    const size_t operations = 5000000;
+
+    vector<Doctor> doctors;
+    vector<vector<pair<string, string>>> bookedPairs(doctorCount);  // the old linear schedule
+    const char* weekdays[] = {"Monday", "Tuesday", "Wednesday", "Thursday", "Friday"};
+    for (int d = 0; d < doctorCount; d++) {
+        doctors.emplace_back("D" + to_string(d), "Doctor", 0, "0900000000", "d@mail.et", 500);
+        for (const char* day : weekdays) {
+            doctors.back().addSchedule(day, "08:00-12:00");
+            doctors.back().addSchedule(day, "13:00-17:00");
+        }
+    }
+
+    mt19937 rng(9);
+    vector<int> doctorOf(operations), dayOf(operations), slotOf(operations);
+    for (size_t i = 0; i < operations; i++) {
+        doctorOf[i] = rng() % doctorCount;
+        dayOf[i] = firstDay + rng() % days;
+        slotOf[i] = 16 + rng() % 18;
+    }
+
+    auto start = chrono::steady_clock::now();
+    size_t booked = 0;
+    for (size_t i = 0; i < operations; i++) {
+        booked += doctors[doctorOf[i]].bookSlot(dayOf[i], slotOf[i]);
+    }
+    double bookNs = nanosPerOp(start, operations);
+
+    start = chrono::steady_clock::now();
+    size_t available = 0;
+    for (size_t i = 0; i < operations; i++) {
+        available += doctors[doctorOf[i]].isAvailable(dayOf[i], slotOf[i] ^ 1);
+    }
+    double checkNs = nanosPerOp(start, operations);
+
+    start = chrono::steady_clock::now();
+    long long weekFree = 0;
+    for (size_t i = 0; i < operations / 10; i++) {
+        weekFree += doctors[doctorOf[i]].getFreeSlotsInWeek(dayOf[i]);
+    }
+    double weekNs = nanosPerOp(start, operations / 10);
+
+    start = chrono::steady_clock::now();
+    size_t released = 0;
+    for (size_t i = 0; i < operations; i += 2) {
+        released += doctors[doctorOf[i]].releaseSlot(dayOf[i], slotOf[i]);
+    }
+    double cancelNs = nanosPerOp(start, operations / 2);
+
+    // A linear search over (date, time) string pairs, as the old schedule did
+    const size_t linearOps = 200000;
+    for (size_t i = 0; i < linearOps; i++) {
+        bookedPairs[doctorOf[i]].emplace_back(to_string(dayOf[i]), formatSlot(slotOf[i]));
+    }
+    start = chrono::steady_clock::now();
+    size_t linearHits = 0;
+    for (size_t i = 0; i < linearOps; i++) {
+        const auto& list = bookedPairs[doctorOf[i]];
+        linearHits += find(list.begin(), list.end(),
+                           make_pair(to_string(dayOf[i]), formatSlot(slotOf[i] ^ 1))) != list.end();
+    }
+    double linearNs = nanosPerOp(start, linearOps);
+
+    cout << "\nCalendar of " << doctorCount << " doctors x " << days << " days, "
+         << operations << " random operations" << endl;
+    cout << fixed << setprecision(1);
+    cout << "Book slot:            " << bookNs << " ns/op (" << booked << " booked)" << endl;
+    cout << "Availability check:   " << checkNs << " ns/op (" << available << " free)" << endl;
+    cout << "Cancel slot:          " << cancelNs << " ns/op (" << released << " released)" << endl;
+    cout << "Free slots this week: " << weekNs << " ns/op (avg "
+         << weekFree / double(operations / 10) << ")" << endl;
+    cout << "Linear string search: " << linearNs << " ns/op (" << linearHits << " hits, "
+         << linearOps << " bookings)" << endl;
+}
+
+void runEarliestSlotBenchmark() {
+    const int doctorCount = 5000;
+    const int specializations = 40;
+    const int steps = 200000;
+    const int firstDay = parseDayNumber("05/01/2026");  // a Monday
+
+    HospitalManagementSystem system;
+    const char* weekdays[] = {"Monday", "Tuesday", "Wednesday", "Thursday", "Friday"};
+    for (int d = 0; d < doctorCount; d++) {
+        string id = "D" + to_string(d);
+        system.addDoctor(id, "Doctor " + to_string(d), "Specialty" + to_string(d % specializations),
+                         "0900000000", "d@mail.et", 500);
+        for (const char* day : weekdays) system.addDoctorSchedule(id, day, "08:00-16:00");
+    }
+    system.addPatient("P1", "Patient", 40, "F", "0900000000", "Addis Ababa", "O+");
+
+    // Each step asks for the earliest slot from a clock that moves forward
+    // through the days and usually books it, as a triage desk would; every
+    // tenth query looks back to an earlier time, as a records desk would
+    mt19937 rng(21);
+    vector<double> indexedNs, scanNs;
+    size_t mismatches = 0, booked = 0;
+    for (int step = 0; step < steps; step++) {
+        string specialization = "Specialty" + to_string(rng() % specializations);
+        int now = firstDay * SLOTS_PER_DAY + (step % 10 == 9 ? int(rng() % (step / 50 + 1)) : step / 50);
+        string date = formatDayNumber(now / SLOTS_PER_DAY);
+        string time = formatSlot(now % SLOTS_PER_DAY);
+
+        auto t0 = chrono::steady_clock::now();
+        pair<int, int> fast = system.findEarliestSlot(specialization, date, time);
+        auto t1 = chrono::steady_clock::now();
+        pair<int, int> slow = system.scanEarliestSlot(specialization, now);
+        auto t2 = chrono::steady_clock::now();
+        indexedNs.push_back(chrono::duration<double, nano>(t1 - t0).count());
+        scanNs.push_back(chrono::duration<double, nano>(t2 - t1).count());
+        if (fast.first != slow.first) mismatches++;
+
+        if (fast.first >= 0 && rng() % 4 != 0) {
+            string appointmentId = system.scheduleAppointment(
+                "P1", system.getDoctorId(fast.second), formatDayNumber(fast.first / SLOTS_PER_DAY),
+                formatSlot(fast.first % SLOTS_PER_DAY));
+            booked += !appointmentId.empty();
         }
     }
+
+    auto average = [](const vector<double>& values) {
+        double total = 0;
+        for (double v : values) total += v;
+        return total / max<size_t>(1, values.size());
+    };
+    cout << "\n" << doctorCount << " doctors in " << specializations << " specializations, "
+         << steps << " earliest-slot queries, " << booked << " bookings" << endl;
+    cout << fixed << setprecision(0);
+    cout << "Scan every doctor: " << average(scanNs) << " ns/query" << endl;
+    cout << "Indexed queue:     " << average(indexedNs) << " ns/query" << endl;
+    cout << "Mismatched answers: " << mismatches << endl;
+}
+
+// What Patient used to carry inline, for the memory comparison
+struct InlineClinicalRecord {
+    vector<string> medicalHistory;
+    vector<string> currentMedications;
+    vector<string> allergies;
 };
 
+size_t inlineRecordBytes(const InlineClinicalRecord& record) {
+    size_t bytes = sizeof(record);
+    for (const vector<string>* list : {&record.medicalHistory, &record.currentMedications, &record.allergies}) {
+        bytes += list->capacity() * sizeof(string);
+        for (const string& text : *list) bytes += text.capacity() > 15 ? text.capacity() + 1 : 0;
+    }
+    return bytes;
+}
+
+void runClinicalHistoryBenchmark() {
+    const int patientCount = 1000000;
+    const char* conditions[] = {"Hypertension", "Type 2 diabetes mellitus", "Asthma", "Malaria (treated)",
+                                "Tuberculosis (completed treatment)", "Chronic kidney disease stage 2",
+                                "Iron deficiency anaemia", "Migraine without aura"};
+    const char* medications[] = {"Amlodipine 5mg once daily", "Metformin 500mg twice daily",
+                                 "Salbutamol inhaler as needed", "Ferrous sulphate 200mg daily",
+                                 "Paracetamol 1g as needed", "Atorvastatin 20mg at night"};
+    const char* allergens[] = {"Penicillin", "Sulfonamides", "Peanuts", "Latex"};
+
+    mt19937 rng(17);
+    vector<InlineClinicalRecord> inlineRecords(patientCount);
+    ClinicalHistoryStore store;
+    vector<uint32_t> handles(patientCount);
+    time_t admitted = 1767225600;
+
+    auto start = chrono::steady_clock::now();
+    size_t inlineBytes = 0;
+    for (int p = 0; p < patientCount; p++) {
+        InlineClinicalRecord& record = inlineRecords[p];
+        handles[p] = store.createHistory();
+        int visits = 2 + rng() % 10;
+        for (int v = 0; v < visits; v++) {
+            time_t when = admitted + v * 86400;
+            const char* condition = conditions[rng() % 8];
+            record.medicalHistory.push_back(condition);
+            store.append(handles[p], ClinicalEntryType::Condition, condition, when);
+            if (rng() % 2) {
+                const char* medication = medications[rng() % 6];
+                record.currentMedications.push_back(medication);
+                store.append(handles[p], ClinicalEntryType::Medication, medication, when);
+            }
+        }
+        if (rng() % 5 == 0) {
+            record.allergies.push_back(allergens[rng() % 4]);
+            store.append(handles[p], ClinicalEntryType::Allergy, record.allergies.back(), admitted);
+        }
+        inlineBytes += inlineRecordBytes(record);
+    }
+    double buildSec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    size_t streamed = 0, textBytes = 0;
+    for (int p = 0; p < patientCount; p++) {
+        store.forEach(handles[p], [&](ClinicalEntryType, time_t, const string& text) {
+            streamed++;
+            textBytes += text.size();
+        });
+    }
+    double readSec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    size_t storeBytes = store.memoryBytes() + handles.size() * sizeof(uint32_t);
+    cout << "\nClinical history of " << patientCount << " patients, " << streamed << " entries" << endl;
+    cout << fixed << setprecision(1);
+    cout << "Inline vectors in Patient: " << inlineBytes / 1048576.0 << " MB ("
+         << sizeof(InlineClinicalRecord) << " bytes per Patient before any entry)" << endl;
+    cout << "Append-only block store:   " << storeBytes / 1048576.0 << " MB ("
+         << sizeof(uint32_t) << "-byte handle per Patient)" << endl;
+    cout << "Saving: " << 100.0 * (1.0 - double(storeBytes) / inlineBytes) << "%" << endl;
+    cout << "Store build: " << buildSec << " s, streaming read: " << setprecision(0)
+         << streamed / readSec << " entries/sec (" << textBytes / 1048576 << " MB of text)" << endl;
+}
+
+void runInteractionCheckBenchmark() {
+    const int substanceCount = 2000;
+    const int ruleCount = 20000;
+    const int patientCount = 100000;
+    const int checks = 1000000;
+    const int naiveChecks = 2000;
+
+    HospitalManagementSystem system;
+    mt19937 rng(13);
+    auto substance = [](int i) { return "Substance-" + to_string(i); };
+
+    // Every other rule is an allergy rule (allergen, drug), the rest drug pairs
+    struct Rule {
+        bool allergy;
+        string first, second;
+    };
+    vector<Rule> ruleList;  // what a nested string scan would walk
+    for (int r = 0; r < ruleCount; r++) {
+        int a = rng() % substanceCount, b = rng() % substanceCount;
+        if (a == b) continue;
+        if (r % 2) system.addDrugRule(substance(a), substance(b));
+        else system.addAllergyRule(substance(a), substance(b));
+        ruleList.push_back({r % 2 == 0, substance(a), substance(b)});
+    }
+
+    vector<vector<pair<string, bool>>> profiles(patientCount);  // (name, is allergy)
+    for (int p = 0; p < patientCount; p++) {
+        string id = "P" + to_string(p);
+        system.addPatient(id, "Patient", 40, "F", "0900000000", "Addis Ababa", "O+");
+        int allergies = rng() % 3, medications = rng() % 5;
+        for (int i = 0; i < allergies; i++) {
+            profiles[p].push_back({substance(rng() % substanceCount), true});
+            system.addAllergy(id, profiles[p].back().first);
+        }
+        for (int i = 0; i < medications; i++) {
+            profiles[p].push_back({substance(rng() % substanceCount), false});
+            system.prescribe(id, profiles[p].back().first, true);
+        }
+    }
+
+    vector<int> patientOf(checks);
+    vector<string> drugOf(checks);
+    for (int i = 0; i < checks; i++) {
+        patientOf[i] = rng() % patientCount;
+        drugOf[i] = substance(rng() % substanceCount);
+    }
+
+    auto start = chrono::steady_clock::now();
+    size_t conflicts = 0;
+    for (int i = 0; i < checks; i++) {
+        conflicts += !system.checkPrescription(patientOf[i], drugOf[i]).empty();
+    }
+    double fastNs = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / checks;
+
+    start = chrono::steady_clock::now();
+    size_t naiveConflicts = 0, fastOnSample = 0;
+    for (int i = 0; i < naiveChecks; i++) {
+        bool hit = false;
+        for (const auto& existing : profiles[patientOf[i]]) {
+            for (const Rule& rule : ruleList) {
+                if (rule.allergy) {
+                    hit = hit || (existing.second && rule.first == existing.first && rule.second == drugOf[i]);
+                } else {
+                    hit = hit || (!existing.second && ((rule.first == drugOf[i] && rule.second == existing.first) ||
+                                                       (rule.second == drugOf[i] && rule.first == existing.first)));
+                }
+            }
+        }
+        naiveConflicts += hit;
+    }
+    double naiveNs = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / naiveChecks;
+    for (int i = 0; i < naiveChecks; i++) {
+        fastOnSample += !system.checkPrescription(patientOf[i], drugOf[i]).empty();
+    }
+
+    start = chrono::steady_clock::now();
+    size_t batchConflicts = system.recheckAllPatients().size();
+    double batchMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    cout << "\n" << ruleCount << " rules over " << substanceCount << " substances, "
+         << patientCount << " patients" << endl;
+    cout << fixed << setprecision(0);
+    cout << "Nested string scan: " << naiveNs << " ns/check (" << naiveConflicts << " conflicts in "
+         << naiveChecks << ", engine found " << fastOnSample << ")" << endl;
+    cout << "Conflict row AND patient bitset: " << fastNs << " ns/check (" << conflicts << " conflicts in "
+         << checks << ")" << endl;
+    cout << "Batch re-check of all patients: " << setprecision(1) << batchMs << " ms ("
+         << batchConflicts << " conflicting pairs)" << endl;
+
+    // A patient's own allergen, in any case, must be refused even when no rule names it
+    size_t allergicAsked = 0, allergicRefused = 0;
+    for (int p = 0; p < patientCount && allergicAsked < 1000; p++) {
+        string id = "P" + to_string(p), unlisted = "Unlisted-" + to_string(p);
+        system.addAllergy(id, unlisted);
+        string shouted = profiles[p].empty() || !profiles[p][0].second ? unlisted : profiles[p][0].first;
+        for (char& c : shouted) c = toupper(c);
+        allergicAsked++;
+        allergicRefused += !system.prescribe(id, " " + shouted);
+    }
+    cout << "Own allergen prescribed: " << allergicRefused << " of " << allergicAsked << " refused" << endl;
+}
+
+void runBatchSchedulingBenchmark() {
+    const int doctorCount = 5000;
+    const int specializationCount = 25;
+    const int requestCount = 100000;
+    const string date = "02/03/2026";  // a Monday
+    const char* weekdays[] = {"Monday", "Tuesday", "Wednesday", "Thursday", "Friday"};
+
+    HospitalManagementSystem online, batch;
+    for (HospitalManagementSystem* system : {&online, &batch}) {
+        for (int d = 0; d < doctorCount; d++) {
+            string id = "D" + to_string(d);
+            system->addDoctor(id, "Doctor", "Spec-" + to_string(d % specializationCount),
+                              "0900000000", "d@mail.et", 500);
+            for (const char* day : weekdays) {
+                system->addDoctorSchedule(id, day, "08:00-12:00");
+                system->addDoctorSchedule(id, day, "13:00-17:00");
+            }
+        }
+    }
+
+    // A morning flood: most patients ask for a narrow early window
+    mt19937 rng(17);
+    vector<AppointmentRequest> requests;
+    for (int i = 0; i < requestCount; i++) {
+        string patientId = "P" + to_string(i);
+        online.addPatient(patientId, "Patient", 30, "M", "0900000000", "Addis Ababa", "A+");
+        batch.addPatient(patientId, "Patient", 30, "M", "0900000000", "Addis Ababa", "A+");
+        int from = rng() % 3 == 0 ? 8 + rng() % 8 : 8 + rng() % 3;
+        int hours = rng() % 2 == 0 ? 1 : 1 + rng() % 8;
+        int to = min(17, from + hours);
+        if (from == 12) from = 13;
+        if (to <= from) to = from + 1;
+        requests.push_back({patientId, "Spec-" + to_string(rng() % specializationCount), date,
+                            formatSlot(from * 60 / SLOT_MINUTES) + "-" + formatSlot(to * 60 / SLOT_MINUTES)});
+    }
+
+    // One at a time: take the earliest free slot from the window's start
+    auto start = chrono::steady_clock::now();
+    size_t onlineFilled = 0;
+    int firstSlot = parseDayNumber(date) * SLOTS_PER_DAY;
+    for (const AppointmentRequest& request : requests) {
+        uint64_t window = parseSlotRange(request.window);
+        string from = request.window.substr(0, 5);
+        pair<int, int> earliest = online.findEarliestSlot(request.specialization, date, from);
+        int slot = earliest.first - firstSlot;
+        if (earliest.first < 0 || slot >= SLOTS_PER_DAY || !((window >> slot) & 1)) continue;
+        onlineFilled += !online.scheduleAppointment(request.patientId, online.getDoctorId(earliest.second),
+                                                    date, formatSlot(slot)).empty();
+    }
+    double onlineMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    int threadCount = max(1u, thread::hardware_concurrency());
+    start = chrono::steady_clock::now();
+    vector<string> appointmentIds = batch.scheduleBatch(requests, threadCount);
+    double batchMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    size_t batchFilled = requestCount - count(appointmentIds.begin(), appointmentIds.end(), "");
+
+    cout << "\n" << requestCount << " requests, " << doctorCount << " doctors in "
+         << specializationCount << " specializations, one day" << endl;
+    cout << fixed << setprecision(1);
+    cout << "One at a time: " << onlineMs << " ms (" << requestCount / onlineMs * 1000 << " req/s), filled "
+         << 100.0 * onlineFilled / requestCount << "%" << endl;
+    cout << "Batch on " << threadCount << " thread(s): " << batchMs << " ms ("
+         << requestCount / batchMs * 1000 << " req/s), filled " << 100.0 * batchFilled / requestCount << "%" << endl;
+}
+
+// Heap bytes a string of this length used when stored per record
+size_t stringBytes(const string& text) {
+    return sizeof(string) + (text.capacity() > 15 ? text.capacity() + 1 : 0);
+}
+
+void runAttributeInterningBenchmark() {
+    const int patientCount = 1000000;
+    const int doctorCount = 100000;
+    const int appointmentCount = 1000000;
+    const int rounds = 20;
+    const char* groups[] = {"A+", "A-", "B+", "B-", "AB+", "AB-", "O+", "O-"};
+    const char* fields[] = {"Cardiology", "Paediatrics", "Obstetrics and Gynaecology", "Internal Medicine",
+                            "General Surgery", "Ophthalmology", "Dermatology", "Psychiatry",
+                            "Orthopaedic Surgery", "Ear, Nose and Throat"};
+    const char* days[] = {"Monday", "Tuesday", "Wednesday", "Thursday", "Friday"};
+    const char* statuses[] = {"Scheduled", "Completed", "Cancelled"};
+    mt19937 rng(23);
+
+    // The same attributes as the old per-record strings and as interned ids
+    vector<string> bloodText(patientCount), specializationText(doctorCount), statusText(appointmentCount);
+    vector<uint16_t> bloodIds(patientCount), specializationIds(doctorCount);
+    vector<AppointmentStatus> statusIds(appointmentCount);
+    AttributeTable bloodGroups, specializations;
+    size_t before = 0, after;
+    for (int i = 0; i < patientCount; i++) {
+        bloodText[i] = groups[rng() % 8];
+        bloodIds[i] = bloodGroups.intern(bloodText[i]);
+        before += stringBytes(bloodText[i]);
+    }
+    for (int i = 0; i < doctorCount; i++) {
+        specializationText[i] = fields[rng() % 10];
+        specializationIds[i] = specializations.intern(specializationText[i]);
+        before += stringBytes(specializationText[i]);
+        for (const char* day : days) before += stringBytes(day) - 1;  // vs a one-byte weekday
+    }
+    for (int i = 0; i < appointmentCount; i++) {
+        int status = rng() % 3;
+        statusText[i] = statuses[status];
+        statusIds[i] = AppointmentStatus(status);
+        before += stringBytes(statusText[i]) - 1;  // vs a one-byte enum
+    }
+    after = (patientCount + doctorCount) * sizeof(uint16_t) + appointmentCount * sizeof(AppointmentStatus) +
+            doctorCount * 5 * sizeof(uint8_t);
+
+    auto timeScan = [&](auto scan) {
+        auto start = chrono::steady_clock::now();
+        volatile size_t matches = 0;  // keeps each scan inside the timed region
+        for (int r = 0; r < rounds; r++) matches = matches + scan(r);
+        return make_pair(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / rounds,
+                         matches / rounds);
+    };
+
+    auto bloodBefore = timeScan([&](int r) {
+        const string wanted = groups[r % 8];
+        return count(bloodText.begin(), bloodText.end(), wanted);
+    });
+    auto bloodAfter = timeScan([&](int r) {
+        uint16_t wanted = bloodGroups.find(groups[r % 8]);
+        return count(bloodIds.begin(), bloodIds.end(), wanted);
+    });
+    auto doctorsBefore = timeScan([&](int r) {
+        const string wanted = fields[r % 10];
+        return count(specializationText.begin(), specializationText.end(), wanted);
+    });
+    auto doctorsAfter = timeScan([&](int r) {
+        uint16_t wanted = specializations.find(fields[r % 10]);
+        return count(specializationIds.begin(), specializationIds.end(), wanted);
+    });
+    auto statusBefore = timeScan([&](int) {
+        return count(statusText.begin(), statusText.end(), string("Scheduled"));
+    });
+    auto statusAfter = timeScan([&](int) {
+        return count(statusIds.begin(), statusIds.end(), AppointmentStatus::Scheduled);
+    });
+
+    cout << "\n" << patientCount << " patients, " << doctorCount << " doctors (5 schedule days each), "
+         << appointmentCount << " appointments" << endl;
+    cout << fixed << setprecision(1);
+    cout << "Attribute memory: " << before / 1048576.0 << " MB as strings, "
+         << after / 1048576.0 << " MB as ids" << endl;
+    cout << setprecision(2);
+    cout << "Patients by blood group:   " << bloodBefore.first << " ms -> " << bloodAfter.first
+         << " ms (" << bloodAfter.second << " matches)" << endl;
+    cout << "Doctors by specialization: " << doctorsBefore.first << " ms -> " << doctorsAfter.first
+         << " ms (" << doctorsAfter.second << " matches)" << endl;
+    cout << "Appointments by status:    " << statusBefore.first << " ms -> " << statusAfter.first
+         << " ms (" << statusAfter.second << " matches)" << endl;
+}
+
+void runBenchmarks() {
+    int choice;
+    cout << "\n=== Benchmarks ===" << endl;
+    cout << "1. Appointment Calendar (5k doctors x 1 year)" << endl;
+    cout << "2. Earliest Slot by Specialization" << endl;
+    cout << "3. Clinical History Store (1M patients)" << endl;
+    cout << "4. Prescription Interaction Check" << endl;
+    cout << "5. Batch Appointment Scheduling (100k requests)" << endl;
+    cout << "6. Interned Attributes vs Strings" << endl;
+    cout << "Enter your choice: ";
+    cin >> choice;
+
+    switch (choice) {
+        case 1:
+            runCalendarBenchmark();
+            break;
+        case 2:
+            runEarliestSlotBenchmark();
+            break;
+        case 3:
+            runClinicalHistoryBenchmark();
+            break;
+        case 4:
+            runInteractionCheckBenchmark();
+            break;
+        case 5:
+            runBatchSchedulingBenchmark();
+            break;
+        case 6:
+            runAttributeInterningBenchmark();
+            break;
+        default:
+            cout << "\nInvalid choice!" << endl;
+    }
+}
+
 int main() {
     HospitalManagementSystem system;
     int choice;
@@ -441,8 +2201,17 @@ int main() {
         cout << "7. Display Doctor Information" << endl;
         cout << "8. Display All Appointments" << endl;
         cout << "9. Search Doctors by Specialization" << endl;
-        cout << "10. Exit" << endl;
-        cout << "Enter your choice (1-10): ";
+        cout << "10. Cancel Appointment" << endl;
+        cout << "11. Doctor's Free Slots" << endl;
+        cout << "12. Earliest Appointment by Specialization" << endl;
+        cout << "13. Complete Appointment" << endl;
+        cout << "14. Appointment Lists" << endl;
+        cout << "15. Update Allergies" << endl;
+        cout << "16. Load Interaction Rules" << endl;
+        cout << "17. Batch Schedule Appointments" << endl;
+        cout << "18. Benchmarks" << endl;
+        cout << "19. Exit" << endl;
+        cout << "Enter your choice (1-19): ";
         cin >> choice;
 
         switch (choice) {
@@ -474,6 +2243,33 @@ int main() {
                 system.searchDoctorsBySpecialization();
                 break;
             case 10:
+                system.cancelAppointment();
+                break;
+            case 11:
+                system.displayFreeSlots();
+                break;
+            case 12:
+                system.findEarliestAppointment();
+                break;
+            case 13:
+                system.completeAppointment();
+                break;
+            case 14:
+                system.displayAppointmentLists();
+                break;
+            case 15:
+                system.updateAllergies();
+                break;
+            case 16:
+                system.loadInteractionRules();
+                break;
+            case 17:
+                system.scheduleBatchFromFile();
+                break;
+            case 18:
+                runBenchmarks();
+                break;
+            case 19:
                 cout << "\nThank you for using Hospital Management System!" << endl;
                 return 0;
             default:
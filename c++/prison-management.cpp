@@ -2,11 +2,169 @@
 #include <iomanip>
 #include <string>
 #include <vector>
+#include <array>
 #include <map>
+#include <unordered_map>
+#include <chrono>
+#include <random>
 #include <ctime>
 #include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <atomic>
+#include <thread>
 using namespace std;
 
+// Days since 01/01/1970 for the calendar date
+int dayNumberOf(int y, int m, int d) {
+    y -= m <= 2;
+    int era = (y >= 0 ? y : y - 399) / 400;
+    int yoe = y - era * 400;
+    int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+// Days since 01/01/1970 for "DD/MM/YYYY", -1 if malformed or not a real date
+int parseDayNumber(const string& date) {
+    int d, m, y;
+    char s1, s2;
+    if (sscanf(date.c_str(), "%d%c%d%c%d", &d, &s1, &m, &s2, &y) != 5 ||
+        s1 != '/' || s2 != '/' || m < 1 || m > 12 || d < 1) {
+        return -1;
+    }
+    static const int monthDays[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leap = y % 4 == 0 && (y % 100 != 0 || y % 400 == 0);
+    if (d > monthDays[m - 1] + (m == 2 && leap)) return -1;
+    return dayNumberOf(y, m, d);
+}
+
+// The local calendar day right now, as a day number
+int localToday() {
+    time_t now = time(0);
+    tm local = *localtime(&now);
+    return dayNumberOf(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday);
+}
+
+// Local midnight at the start of the day number; mktime normalizes the day of month
+time_t localDayStart(int day) {
+    tm when = {};
+    when.tm_year = 70;
+    when.tm_mday = 1 + day;
+    when.tm_isdst = -1;
+    return mktime(&when);
+}
+
+// Inverse of parseDayNumber
+string formatDate(int day) {
+    int z = day + 719468;
+    int era = (z >= 0 ? z : z - 146096) / 146097;
+    int doe = z - era * 146097;
+    int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int mp = (5 * doy + 2) / 153;
+    int d = doy - (153 * mp + 2) / 5 + 1;
+    int m = mp + (mp < 10 ? 3 : -9);
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%02d/%02d/%04d", d, m, yoe + era * 400 + (m <= 2));
+    return buffer;
+}
+
+string formatTime(time_t when) {
+    string date = ctime(&when);
+    return date.substr(0, date.length() - 1);  // Remove newline
+}
+
+enum class InmateEventType : uint8_t { Behavior, Medical };
+
+// Append-only log of behavior and medical events with binary timestamps.
+// Events are partitioned by week, and each partition keeps its events in time
+// order, overall and per cell block, so a time range or block query only
+// scans the weeks it overlaps.
+class InmateEventStore {
+private:
+    struct Event {
+        int64_t time;
+        uint32_t inmate;
+        int16_t block;  // cell block index when recorded, -1 if none
+        InmateEventType type;
+    };
+
+    struct Partition {
+        vector<uint32_t> events;
+        unordered_map<int, vector<uint32_t>> byBlock;
+    };
+
+    static const int64_t PARTITION_SECONDS = 7 * 86400;
+
+    vector<Event> events;
+    vector<string> texts;                // event -> text
+    vector<vector<uint32_t>> byInmate;   // inmate -> events in insertion order
+    map<int64_t, Partition> partitions;  // week number -> events in time order
+
+    // Events are usually appended in time order; backdated ones are inserted in place
+    void insertByTime(vector<uint32_t>& list, uint32_t event) {
+        auto later = [&](uint32_t other) { return events[other].time > events[event].time; };
+        if (list.empty() || !later(list.back())) {
+            list.push_back(event);
+            return;
+        }
+        list.insert(upper_bound(list.begin(), list.end(), event, [&](uint32_t a, uint32_t b) {
+            return events[a].time < events[b].time;
+        }), event);
+    }
+
+    static int64_t weekOf(int64_t time) {
+        return time >= 0 ? time / PARTITION_SECONDS : (time + 1) / PARTITION_SECONDS - 1;
+    }
+
+public:
+    void append(int inmate, int block, InmateEventType type, const string& text, time_t when = time(0)) {
+        uint32_t id = events.size();
+        events.push_back({int64_t(when), uint32_t(inmate), int16_t(block), type});
+        texts.push_back(text);
+        if (inmate >= int(byInmate.size())) byInmate.resize(inmate + 1);
+        byInmate[inmate].push_back(id);
+        Partition& partition = partitions[weekOf(when)];
+        insertByTime(partition.events, id);
+        if (block >= 0) insertByTime(partition.byBlock[block], id);
+    }
+
+    // visit(time, inmate, block, type, text) for each event of the inmate
+    template <typename Visitor>
+    void forEachOfInmate(int inmate, Visitor visit) const {
+        if (inmate >= int(byInmate.size())) return;
+        for (uint32_t id : byInmate[inmate]) {
+            const Event& e = events[id];
+            visit(time_t(e.time), int(e.inmate), int(e.block), e.type, texts[id]);
+        }
+    }
+
+    // The same visitor for events in [from, to), optionally only in one block
+    // (block >= 0), in time order
+    template <typename Visitor>
+    void forEachInRange(time_t from, time_t to, int block, Visitor visit) const {
+        if (from >= to) return;
+        auto last = partitions.upper_bound(weekOf(to - 1));
+        for (auto it = partitions.lower_bound(weekOf(from)); it != last; ++it) {
+            const vector<uint32_t>* list = &it->second.events;
+            if (block >= 0) {
+                auto blockIt = it->second.byBlock.find(block);
+                if (blockIt == it->second.byBlock.end()) continue;
+                list = &blockIt->second;
+            }
+            auto begin = lower_bound(list->begin(), list->end(), int64_t(from),
+                                     [&](uint32_t id, int64_t t) { return events[id].time < t; });
+            for (auto e = begin; e != list->end() && events[*e].time < to; ++e) {
+                const Event& event = events[*e];
+                visit(time_t(event.time), int(event.inmate), int(event.block), event.type, texts[*e]);
+            }
+        }
+    }
+
+    size_t size() const { return events.size(); }
+};
+
 class Inmate {
 private:
     string id;
@@ -19,8 +177,6 @@ private:
     string releaseDate;
     string cellBlock;
     int cellNumber;
-    vector<string> behaviorRecords;
-    vector<string> medicalRecords;
     bool isReleased;
 
 public:
@@ -32,6 +188,9 @@ public:
 
     string getId() const { return id; }
     string getName() const { return name; }
+    string getGender() const { return gender; }
+    string getCrime() const { return crime; }
+    string getReleaseDate() const { return releaseDate; }
     bool getIsReleased() const { return isReleased; }
     string getCellBlock() const { return cellBlock; }
     int getCellNumber() const { return cellNumber; }
@@ -41,27 +200,14 @@ public:
         cellNumber = number;
     }
 
-    void addBehaviorRecord(const string& record) {
-        time_t now = time(0);
-        string date = ctime(&now);
-        date = date.substr(0, date.length() - 1);  // Remove newline
-        behaviorRecords.push_back(date + ": " + record);
-    }
-
-    void addMedicalRecord(const string& record) {
-        time_t now = time(0);
-        string date = ctime(&now);
-        date = date.substr(0, date.length() - 1);  // Remove newline
-        medicalRecords.push_back(date + ": " + record);
-    }
-
     void release() {
         isReleased = true;
         cellBlock = "";
         cellNumber = -1;
     }
 
-    void displayInfo() const {
+    // Behavior and medical records live in the event store under the inmate's index
+    void displayInfo(const InmateEventStore& events, int self) const {
         cout << "\nInmate Details:" << endl;
         cout << "ID: " << id << endl;
         cout << "Name: " << name << endl;
@@ -78,21 +224,21 @@ public:
             cout << "Cell Number: " << cellNumber << endl;
         }
 
-        cout << "\nBehavior Records:" << endl;
-        if (behaviorRecords.empty()) cout << "No behavior records." << endl;
-        else {
-            for (const auto& record : behaviorRecords) {
-                cout << "- " << record << endl;
-            }
-        }
+        displayRecords(events, self, InmateEventType::Behavior, "Behavior Records", "No behavior records.");
+        displayRecords(events, self, InmateEventType::Medical, "Medical Records", "No medical records.");
+    }
 
-        cout << "\nMedical Records:" << endl;
-        if (medicalRecords.empty()) cout << "No medical records." << endl;
-        else {
-            for (const auto& record : medicalRecords) {
-                cout << "- " << record << endl;
-            }
-        }
+private:
+    void displayRecords(const InmateEventStore& events, int self, InmateEventType wanted,
+                        const string& title, const string& emptyMessage) const {
+        cout << "\n" << title << ":" << endl;
+        bool any = false;
+        events.forEachOfInmate(self, [&](time_t when, int, int, InmateEventType type, const string& text) {
+            if (type != wanted) return;
+            cout << "- " << formatTime(when) << ": " << text << endl;
+            any = true;
+        });
+        if (!any) cout << emptyMessage << endl;
     }
 };
 
@@ -116,6 +262,7 @@ public:
     string getId() const { return id; }
     string getName() const { return name; }
     string getDepartment() const { return department; }
+    string getShift() const { return shift; }
 
     void addDutyRecord(const string& record) {
         time_t now = time(0);
@@ -187,6 +334,915 @@ public:
     }
 };
 
+// Who visited whom, as a bipartite graph over visitor and inmate indexes. Both
+// directions are kept in compressed sparse row form: row v of the visitor side
+// lists the distinct inmates v visited, sorted, and the inmate side is the
+// transpose. New visits land in a per-node delta buffer that queries merge on
+// the fly; once it holds a quarter as many visits as were recorded before, it
+// is folded into the rows in one linear pass.
+class VisitGraph {
+private:
+    struct Side {
+        vector<uint32_t> offsets{0};  // node -> start of its row; one extra entry
+        vector<uint32_t> neighbors;
+        // Pending neighbors as a chain per node, newest first
+        vector<int32_t> pendingHead;   // node -> last pending entry, -1 if none
+        vector<uint32_t> pendingNeighbor;
+        vector<int32_t> pendingNext;
+        vector<uint32_t> touched;      // nodes with pending entries
+
+        size_t nodeCount() const { return offsets.size() - 1; }
+
+        void add(uint32_t node, uint32_t neighbor) {
+            if (node >= pendingHead.size()) pendingHead.resize(node + 1, -1);
+            if (pendingHead[node] < 0) touched.push_back(node);
+            pendingNeighbor.push_back(neighbor);
+            pendingNext.push_back(pendingHead[node]);
+            pendingHead[node] = pendingNeighbor.size() - 1;
+        }
+
+        // Appends the node's sorted, distinct neighbors including pending ones
+        void appendRow(uint32_t node, vector<uint32_t>& out) const {
+            size_t start = out.size();
+            if (node < nodeCount()) {
+                out.insert(out.end(), neighbors.begin() + offsets[node], neighbors.begin() + offsets[node + 1]);
+            }
+            if (node >= pendingHead.size() || pendingHead[node] < 0) return;
+            size_t added = out.size();
+            for (int32_t e = pendingHead[node]; e >= 0; e = pendingNext[e]) out.push_back(pendingNeighbor[e]);
+            sort(out.begin() + added, out.end());
+            inplace_merge(out.begin() + start, out.begin() + added, out.end());
+            out.erase(unique(out.begin() + start, out.end()), out.end());
+        }
+
+        vector<uint32_t> row(uint32_t node) const {
+            vector<uint32_t> result;
+            appendRow(node, result);
+            return result;
+        }
+
+        // Copies untouched rows as they are and merges pending entries into the rest
+        void compact(size_t nodes) {
+            sort(touched.begin(), touched.end());
+            vector<uint32_t> newOffsets, newNeighbors;
+            newOffsets.reserve(nodes + 1);
+            newOffsets.push_back(0);
+            newNeighbors.reserve(neighbors.size() + pendingNeighbor.size());
+            size_t next = 0;
+            for (uint32_t node = 0; node < nodes; node++) {
+                if (next < touched.size() && touched[next] == node) {
+                    appendRow(node, newNeighbors);
+                    pendingHead[touched[next++]] = -1;
+                } else if (node < nodeCount()) {
+                    newNeighbors.insert(newNeighbors.end(), neighbors.begin() + offsets[node],
+                                        neighbors.begin() + offsets[node + 1]);
+                }
+                newOffsets.push_back(newNeighbors.size());
+            }
+            offsets.swap(newOffsets);
+            neighbors.swap(newNeighbors);
+            pendingNeighbor.clear();
+            pendingNext.clear();
+            touched.clear();
+        }
+    };
+
+    Side visitorSide;  // visitor -> inmates
+    Side inmateSide;   // inmate -> visitors
+    size_t visitorCount = 0;
+    size_t inmateCount = 0;
+    size_t pending = 0;
+    size_t visitCount = 0;
+
+public:
+    void addVisit(uint32_t visitor, uint32_t inmate) {
+        visitorSide.add(visitor, inmate);
+        inmateSide.add(inmate, visitor);
+        visitorCount = max<size_t>(visitorCount, visitor + 1);
+        inmateCount = max<size_t>(inmateCount, inmate + 1);
+        visitCount++;
+        if (++pending > max<size_t>(1024, visitCount / 4)) compact();
+    }
+
+    void compact() {
+        visitorSide.compact(visitorCount);
+        inmateSide.compact(inmateCount);
+        pending = 0;
+    }
+
+    vector<uint32_t> inmatesVisitedBy(uint32_t visitor) const { return visitorSide.row(visitor); }
+    vector<uint32_t> visitorsOf(uint32_t inmate) const { return inmateSide.row(inmate); }
+
+    // Visitors who saw both inmates
+    vector<uint32_t> commonVisitors(uint32_t a, uint32_t b) const {
+        vector<uint32_t> first = visitorsOf(a), second = visitorsOf(b), result;
+        set_intersection(first.begin(), first.end(), second.begin(), second.end(), back_inserter(result));
+        return result;
+    }
+
+    // Inmates reachable through at most hops shared visitors, with their
+    // distance in hops, nearest first; the start inmate is not included
+    vector<pair<uint32_t, int>> associates(uint32_t inmate, int hops) const {
+        vector<pair<uint32_t, int>> result;
+        vector<bool> seenInmate(inmateCount, false), seenVisitor(visitorCount, false);
+        if (inmate >= inmateCount) return result;
+        vector<uint32_t> frontier{inmate};
+        seenInmate[inmate] = true;
+        for (int hop = 1; hop <= hops && !frontier.empty(); hop++) {
+            vector<uint32_t> next;
+            for (uint32_t current : frontier) {
+                for (uint32_t visitor : visitorsOf(current)) {
+                    if (seenVisitor[visitor]) continue;
+                    seenVisitor[visitor] = true;
+                    for (uint32_t other : inmatesVisitedBy(visitor)) {
+                        if (seenInmate[other]) continue;
+                        seenInmate[other] = true;
+                        next.push_back(other);
+                        result.push_back({other, hop});
+                    }
+                }
+            }
+            frontier.swap(next);
+        }
+        return result;
+    }
+
+    size_t getVisitCount() const { return visitCount; }
+    size_t getEdgeCount() const { return visitorSide.neighbors.size(); }
+};
+
+// Occupancy of one cell block as one bit per cell (cell n is bit n - 1). Bits
+// past the capacity are kept set so a free-cell scan never lands on them.
+class CellBlock {
+private:
+    string name;
+    int capacity;
+    char gender;        // 'M', 'F' or '*' for either
+    int securityLevel;  // 1 (minimum) to 3 (maximum)
+    vector<uint64_t> occupiedBits;
+    vector<int> occupants;  // cell number - 1 -> inmate index, -1 if free
+    int occupiedCount;
+
+public:
+    CellBlock(string blockName, int cells, char blockGender, int level)
+        : name(blockName), capacity(cells), gender(toupper(blockGender)), securityLevel(level),
+          occupiedBits((cells + 63) / 64, 0), occupants(cells, -1), occupiedCount(0) {
+        if (cells % 64) occupiedBits.back() = ~0ULL << (cells % 64);
+    }
+
+    string getName() const { return name; }
+    int getCapacity() const { return capacity; }
+    char getGender() const { return gender; }
+    int getSecurityLevel() const { return securityLevel; }
+    int getOccupiedCount() const { return occupiedCount; }
+    int getOccupant(int number) const { return occupants[number - 1]; }
+
+    bool isOccupied(int number) const {
+        return (occupiedBits[(number - 1) / 64] >> ((number - 1) % 64)) & 1;
+    }
+
+    bool occupy(int number, int inmate) {
+        if (number < 1 || number > capacity || isOccupied(number)) return false;
+        occupiedBits[(number - 1) / 64] |= 1ULL << ((number - 1) % 64);
+        occupants[number - 1] = inmate;
+        occupiedCount++;
+        return true;
+    }
+
+    bool vacate(int number) {
+        if (number < 1 || number > capacity || !isOccupied(number)) return false;
+        occupiedBits[(number - 1) / 64] &= ~(1ULL << ((number - 1) % 64));
+        occupants[number - 1] = -1;
+        occupiedCount--;
+        return true;
+    }
+
+    // Lowest free cell number, 0 if the block is full
+    int firstFreeCell() const {
+        if (occupiedCount == capacity) return 0;
+        for (size_t w = 0; w < occupiedBits.size(); w++) {
+            if (~occupiedBits[w]) return w * 64 + __builtin_ctzll(~occupiedBits[w]) + 1;
+        }
+        return 0;
+    }
+
+    // Appends the inmate in every occupied cell, by cell number
+    void appendOccupants(vector<int>& out) const {
+        if (occupiedCount == 0) return;
+        out.reserve(out.size() + occupiedCount);
+        for (size_t w = 0; w < occupiedBits.size(); w++) {
+            uint64_t bits = occupiedBits[w];
+            if (w + 1 == occupiedBits.size() && capacity % 64) bits &= (1ULL << (capacity % 64)) - 1;
+            for (; bits; bits &= bits - 1) out.push_back(occupants[w * 64 + __builtin_ctzll(bits)]);
+        }
+    }
+
+    bool accepts(const string& inmateGender, int minSecurityLevel) const {
+        return securityLevel >= minSecurityLevel &&
+               (gender == '*' || (!inmateGender.empty() && gender == toupper(inmateGender[0])));
+    }
+};
+
+// Inmates by name token and by crime, each list split into incarcerated and
+// released so routine searches never walk the release history. Crimes and
+// tokens compare case-insensitively.
+class InmateSearchIndex {
+private:
+    struct Postings {
+        vector<int> active;
+        vector<int> released;
+    };
+
+    // Where an inmate sits in the active list of one of its name tokens
+    struct TokenRef {
+        const string* token;
+        Postings* postings;
+        uint32_t position;
+    };
+
+    map<string, Postings> nameTokens;
+    vector<vector<TokenRef>> tokensOf;  // inmate -> its entries in nameTokens
+    unordered_map<string, int> crimeIds;
+    vector<Postings> byCrime;
+    vector<int> crimeOf;                // inmate -> crime id
+    vector<uint32_t> crimePosition;     // inmate -> position in its crime's active list
+
+    static string lowercase(string text) {
+        for (char& c : text) c = tolower(c);
+        return text;
+    }
+
+    static vector<string> tokenize(const string& text) {
+        vector<string> result;
+        string token;
+        for (char c : text + " ") {
+            if (isalnum((unsigned char)c)) token += tolower(c);
+            else if (!token.empty()) {
+                result.push_back(token);
+                token.clear();
+            }
+        }
+        return result;
+    }
+
+    // Swap-removes from the active list; returns the inmate moved into the
+    // freed position, -1 if it was the last one
+    static int moveToReleased(Postings& postings, uint32_t position) {
+        int inmate = postings.active[position];
+        int moved = postings.active.back();
+        postings.active[position] = moved;
+        postings.active.pop_back();
+        postings.released.push_back(inmate);
+        return moved == inmate ? -1 : moved;
+    }
+
+    static void collect(const Postings& postings, bool includeReleased, vector<int>& out) {
+        out.insert(out.end(), postings.active.begin(), postings.active.end());
+        if (includeReleased) out.insert(out.end(), postings.released.begin(), postings.released.end());
+    }
+
+public:
+    void add(int inmate, const string& name, const string& crime) {
+        tokensOf.resize(inmate + 1);
+        for (const string& token : tokenize(name)) {
+            auto it = nameTokens.emplace(token, Postings()).first;
+            vector<int>& list = it->second.active;
+            if (!list.empty() && list.back() == inmate) continue;
+            tokensOf[inmate].push_back({&it->first, &it->second, uint32_t(list.size())});
+            list.push_back(inmate);
+        }
+        string key = lowercase(crime);
+        auto it = crimeIds.find(key);
+        if (it == crimeIds.end()) {
+            it = crimeIds.emplace(key, byCrime.size()).first;
+            byCrime.emplace_back();
+        }
+        crimeOf.resize(inmate + 1, -1);
+        crimePosition.resize(inmate + 1, 0);
+        crimeOf[inmate] = it->second;
+        crimePosition[inmate] = byCrime[it->second].active.size();
+        byCrime[it->second].active.push_back(inmate);
+    }
+
+    void release(int inmate) {
+        for (const TokenRef& ref : tokensOf[inmate]) {
+            int moved = moveToReleased(*ref.postings, ref.position);
+            if (moved < 0) continue;
+            for (TokenRef& other : tokensOf[moved]) {
+                if (other.postings == ref.postings) other.position = ref.position;
+            }
+        }
+        int moved = moveToReleased(byCrime[crimeOf[inmate]], crimePosition[inmate]);
+        if (moved >= 0) crimePosition[moved] = crimePosition[inmate];
+    }
+
+    // Inmates whose name has a token starting with each word of the query, in
+    // index order. Candidates come from the word with the fewest postings; the
+    // other words are checked against each candidate's own tokens.
+    vector<int> searchName(const string& query, bool includeReleased) const {
+        vector<int> result;
+        vector<string> words = tokenize(query);
+        if (words.empty()) return result;
+
+        auto prefixRange = [&](const string& word) {
+            auto first = nameTokens.lower_bound(word), last = first;
+            while (last != nameTokens.end() && last->first.compare(0, word.size(), word) == 0) ++last;
+            return make_pair(first, last);
+        };
+        size_t rarest = 0, fewest = SIZE_MAX;
+        for (size_t w = 0; w < words.size(); w++) {
+            size_t postings = 0;
+            auto range = prefixRange(words[w]);
+            for (auto it = range.first; it != range.second; ++it) {
+                postings += it->second.active.size() + (includeReleased ? it->second.released.size() : 0);
+            }
+            if (postings < fewest) {
+                fewest = postings;
+                rarest = w;
+            }
+        }
+
+        auto range = prefixRange(words[rarest]);
+        for (auto it = range.first; it != range.second; ++it) collect(it->second, includeReleased, result);
+        sort(result.begin(), result.end());
+        result.erase(unique(result.begin(), result.end()), result.end());
+
+        auto hasAllWords = [&](int inmate) {
+            for (const string& word : words) {
+                bool matched = false;
+                for (const TokenRef& ref : tokensOf[inmate]) {
+                    if (ref.token->compare(0, word.size(), word) == 0) {
+                        matched = true;
+                        break;
+                    }
+                }
+                if (!matched) return false;
+            }
+            return true;
+        };
+        result.erase(remove_if(result.begin(), result.end(), [&](int inmate) { return !hasAllWords(inmate); }),
+                     result.end());
+        return result;
+    }
+
+    vector<int> searchCrime(const string& crime, bool includeReleased) const {
+        vector<int> result;
+        auto it = crimeIds.find(lowercase(crime));
+        if (it != crimeIds.end()) collect(byCrime[it->second], includeReleased, result);
+        sort(result.begin(), result.end());
+        return result;
+    }
+};
+
+// Incarcerated inmates bucketed by parsed release day in an ordered map, so
+// the releases due in a window are read bucket by bucket without touching
+// anyone due later. Inmates whose release date does not parse (e.g. a life
+// sentence) are not scheduled.
+class ReleaseCalendar {
+private:
+    map<int, vector<int>> buckets;   // release day -> inmates
+    vector<int> dayOf;               // inmate -> scheduled day, -1 if none
+    vector<uint32_t> positionOf;     // inmate -> position in its bucket
+
+public:
+    void schedule(int inmate, int day) {
+        if (inmate >= int(dayOf.size())) {
+            dayOf.resize(inmate + 1, -1);
+            positionOf.resize(inmate + 1, 0);
+        }
+        if (day < 0) return;
+        vector<int>& bucket = buckets[day];
+        dayOf[inmate] = day;
+        positionOf[inmate] = bucket.size();
+        bucket.push_back(inmate);
+    }
+
+    void remove(int inmate) {
+        if (inmate >= int(dayOf.size()) || dayOf[inmate] < 0) return;
+        auto it = buckets.find(dayOf[inmate]);
+        vector<int>& bucket = it->second;
+        int moved = bucket.back();
+        bucket[positionOf[inmate]] = moved;
+        positionOf[moved] = positionOf[inmate];
+        bucket.pop_back();
+        if (bucket.empty()) buckets.erase(it);
+        dayOf[inmate] = -1;
+    }
+
+    // (day, inmate) for releases due on days [from, to], earliest first
+    vector<pair<int, int>> dueBetween(int from, int to) const {
+        vector<pair<int, int>> result;
+        for (auto it = buckets.lower_bound(from); it != buckets.end() && it->first <= to; ++it) {
+            for (int inmate : it->second) result.push_back({it->first, inmate});
+        }
+        return result;
+    }
+
+    // Every scheduled release up to and including the day, including overdue ones
+    vector<pair<int, int>> dueBy(int day) const {
+        return buckets.empty() ? vector<pair<int, int>>() : dueBetween(buckets.begin()->first, day);
+    }
+};
+
+const int VISIT_SESSIONS = 8;    // hourly sessions, 09:00 to 16:00
+const int BOOKING_DAYS = 28;     // how far ahead visits can be booked
+
+string formatSession(int session) {
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "%02d:00", 9 + session);
+    return buffer;
+}
+
+// Monday-based week number for a day from parseDayNumber
+int weekOfDay(int day) {
+    int shifted = day + 3;   // day 0 was a Thursday
+    return shifted >= 0 ? shifted / 7 : (shifted - 6) / 7;
+}
+
+enum class BookingOutcome { Booked, NotFound, InvalidSession, OutsideWindow, SessionFull, QuotaReached };
+
+struct VisitBooking {
+    int visitor;
+    int inmate;
+    int day;
+    int session;
+    bool cancelled;
+};
+
+// Visiting-room capacity per session and a weekly visit quota per inmate,
+// held as counters in rings that cover only the bookable window. A ring
+// entry is tagged with the day (or week) it counts and is cleared when the
+// window moves onto it, so every booking is checked and counted in O(1)
+// without looking at earlier bookings.
+class VisitScheduler {
+private:
+    static const int DAY_RING = 32;   // > BOOKING_DAYS
+    static const int WEEK_RING = 8;   // > weeks touched by BOOKING_DAYS
+
+    struct InmateWeek {
+        int week = INT32_MIN;
+        uint16_t visits = 0;
+    };
+
+    int capacity;
+    int weeklyQuota;
+    array<int, DAY_RING> ringDay;
+    array<array<uint16_t, VISIT_SESSIONS>, DAY_RING> seated;
+    vector<array<InmateWeek, WEEK_RING>> inmateWeeks;
+
+    uint16_t& seatedAt(int day, int session) {
+        int slot = ((day % DAY_RING) + DAY_RING) % DAY_RING;
+        if (ringDay[slot] != day) {
+            ringDay[slot] = day;
+            seated[slot].fill(0);
+        }
+        return seated[slot][session];
+    }
+
+    uint16_t& visitsIn(int inmate, int week) {
+        if (inmate >= int(inmateWeeks.size())) inmateWeeks.resize(inmate + 1);
+        InmateWeek& entry = inmateWeeks[inmate][((week % WEEK_RING) + WEEK_RING) % WEEK_RING];
+        if (entry.week != week) {
+            entry.week = week;
+            entry.visits = 0;
+        }
+        return entry.visits;
+    }
+
+public:
+    VisitScheduler(int sessionCapacity, int visitsPerWeek)
+        : capacity(sessionCapacity), weeklyQuota(visitsPerWeek), seated{} {
+        ringDay.fill(INT32_MIN);
+    }
+
+    int getCapacity() const { return capacity; }
+    int getWeeklyQuota() const { return weeklyQuota; }
+
+    // Counts the visit if the day is within the window starting today and
+    // both the session and the inmate's week have room
+    BookingOutcome book(int inmate, int day, int session, int today) {
+        if (session < 0 || session >= VISIT_SESSIONS) return BookingOutcome::InvalidSession;
+        if (day < today || day >= today + BOOKING_DAYS) return BookingOutcome::OutsideWindow;
+        uint16_t& inSession = seatedAt(day, session);
+        if (inSession >= capacity) return BookingOutcome::SessionFull;
+        uint16_t& inWeek = visitsIn(inmate, weekOfDay(day));
+        if (inWeek >= weeklyQuota) return BookingOutcome::QuotaReached;
+        inSession++;
+        inWeek++;
+        return BookingOutcome::Booked;
+    }
+
+    // Frees the seat and quota of a booking that has not taken place yet
+    void cancel(int inmate, int day, int session, int today) {
+        if (day < today || day >= today + BOOKING_DAYS) return;
+        seatedAt(day, session)--;
+        visitsIn(inmate, weekOfDay(day))--;
+    }
+
+    int seatsLeft(int day, int session, int today) {
+        if (day < today || day >= today + BOOKING_DAYS) return 0;
+        return capacity - seatedAt(day, session);
+    }
+};
+
+// 0 = male, 1 = female, 2 = other or unrecorded
+int genderSlot(const string& gender) {
+    char g = gender.empty() ? ' ' : toupper(gender[0]);
+    return g == 'M' ? 0 : g == 'F' ? 1 : 2;
+}
+
+struct CensusSnapshot {
+    int incarcerated = 0;
+    int released = 0;
+    int unassigned = 0;              // incarcerated without a cell
+    int byGender[3] = {0, 0, 0};     // incarcerated, by genderSlot
+    vector<array<int, 3>> byBlock;   // block -> gender -> occupants
+
+    bool operator==(const CensusSnapshot& other) const {
+        return incarcerated == other.incarcerated && released == other.released &&
+               unassigned == other.unassigned && equal(byGender, byGender + 3, other.byGender) &&
+               byBlock == other.byBlock;
+    }
+};
+
+// Headcounts kept up to date on every admission, cell assignment and release.
+// Writers bump an even/odd version around each update (a sequence lock), so a
+// reader on another thread, such as a roll-call display, can take a consistent
+// snapshot without blocking them. Block slots are preallocated so readers never
+// see storage move.
+class CensusCounters {
+public:
+    static const int MAX_BLOCKS = 256;
+
+private:
+    atomic<uint64_t> version{0};
+    atomic<int> blockCount{0};
+    atomic<int> incarcerated{0};
+    atomic<int> released{0};
+    atomic<int> unassigned{0};
+    atomic<int> byGender[3];
+    atomic<int> byBlock[MAX_BLOCKS][3];
+
+    void beginWrite() {
+        version.store(version.load(memory_order_relaxed) + 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+    }
+
+    void endWrite() { version.store(version.load(memory_order_relaxed) + 1, memory_order_release); }
+
+    static void add(atomic<int>& counter, int delta) {
+        counter.store(counter.load(memory_order_relaxed) + delta, memory_order_relaxed);
+    }
+
+public:
+    CensusCounters() {
+        for (auto& count : byGender) count.store(0, memory_order_relaxed);
+        for (auto& block : byBlock) {
+            for (auto& count : block) count.store(0, memory_order_relaxed);
+        }
+    }
+
+    void onBlockAdded() {
+        beginWrite();
+        add(blockCount, 1);
+        endWrite();
+    }
+
+    void onAdmitted(int gender) {
+        beginWrite();
+        add(incarcerated, 1);
+        add(unassigned, 1);
+        add(byGender[gender], 1);
+        endWrite();
+    }
+
+    void onAssigned(int gender, int block) {
+        beginWrite();
+        add(unassigned, -1);
+        add(byBlock[block][gender], 1);
+        endWrite();
+    }
+
+    // block is -1 if the inmate had no cell
+    void onReleased(int gender, int block) {
+        beginWrite();
+        add(incarcerated, -1);
+        add(released, 1);
+        add(byGender[gender], -1);
+        if (block >= 0) add(byBlock[block][gender], -1);
+        else add(unassigned, -1);
+        endWrite();
+    }
+
+    // Safe from any thread; retries while a write is in progress
+    CensusSnapshot snapshot() const {
+        CensusSnapshot result;
+        uint64_t before, after;
+        do {
+            before = version.load(memory_order_acquire);
+            if (before & 1) continue;
+            result.incarcerated = incarcerated.load(memory_order_relaxed);
+            result.released = released.load(memory_order_relaxed);
+            result.unassigned = unassigned.load(memory_order_relaxed);
+            for (int g = 0; g < 3; g++) result.byGender[g] = byGender[g].load(memory_order_relaxed);
+            result.byBlock.resize(blockCount.load(memory_order_relaxed));
+            for (size_t b = 0; b < result.byBlock.size(); b++) {
+                for (int g = 0; g < 3; g++) result.byBlock[b][g] = byBlock[b][g].load(memory_order_relaxed);
+            }
+            atomic_thread_fence(memory_order_acquire);
+            after = version.load(memory_order_relaxed);
+        } while ((before & 1) || before != after);
+        return result;
+    }
+};
+
+const int SHIFTS_PER_DAY = 3;                      // morning, evening, night
+const int ROSTER_SLOTS = 7 * SHIFTS_PER_DAY;       // Monday morning is slot 0
+
+string formatRosterSlot(int slot) {
+    static const char* days[] = {"Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun"};
+    static const char* shifts[] = {"Morning", "Evening", "Night"};
+    return string(days[slot / SHIFTS_PER_DAY]) + " " + shifts[slot % SHIFTS_PER_DAY];
+}
+
+// Availability from a free-form shift such as "Night"; anything else means any shift
+uint32_t shiftAvailability(const string& shift) {
+    string prefix;
+    for (size_t i = 0; i < shift.size() && i < 3; i++) prefix += tolower(shift[i]);
+    int type = prefix == "mor" ? 0 : prefix == "eve" ? 1 : prefix == "nig" ? 2 : -1;
+    if (type < 0) return (1u << ROSTER_SLOTS) - 1;
+    uint32_t mask = 0;
+    for (int day = 0; day < 7; day++) mask |= 1u << (day * SHIFTS_PER_DAY + type);
+    return mask;
+}
+
+struct Duty {
+    int staff;
+    int post;
+    int slot;
+};
+
+struct RosterIssues {
+    vector<Duty> doubleAssigned;           // a second duty in the same slot
+    vector<Duty> restViolations;           // a duty straight after another
+    vector<Duty> unavailable;              // outside the staff member's availability
+    vector<int> overworked;                // staff over the weekly limit
+    vector<pair<int, int>> understaffed;   // (post, slot)
+    int shortfall = 0;                     // missing staff-shifts over all posts
+};
+
+// Weekly duty roster over ROSTER_SLOTS shifts. Each staff member's
+// availability and worked shifts are bitmaps over the slots, so eligibility
+// (available, free, rested, under the weekly limit) is a few bit operations.
+// Solving fills every slot greedily, least-loaded staff first, then several
+// threads each run an independent local search from that start and the best
+// roster wins: fewest uncovered staff-shifts, then the most even workload.
+class RosterEngine {
+private:
+    struct Roster {
+        vector<uint32_t> worked;    // staff -> slots on duty
+        vector<int16_t> postAt;     // staff * ROSTER_SLOTS + slot -> post, -1 if off
+        vector<uint8_t> covered;    // post * ROSTER_SLOTS + slot -> staff on duty
+        int shortfall = 0;
+        long long loadSquares = 0;  // sum of squared weekly shifts
+
+        bool betterThan(const Roster& other) const {
+            return shortfall != other.shortfall ? shortfall < other.shortfall : loadSquares < other.loadSquares;
+        }
+    };
+
+    vector<uint32_t> availability;                 // staff -> available slots
+    vector<array<uint8_t, ROSTER_SLOTS>> demand;   // post -> staff needed per slot
+    vector<vector<int>> availableIn;               // slot -> staff available
+    int maxShifts;
+
+    static uint32_t neighbours(int slot) {
+        uint32_t bit = 1u << slot;
+        return (bit << 1) | (bit >> 1);
+    }
+
+    bool eligible(const Roster& roster, int staff, int slot) const {
+        uint32_t worked = roster.worked[staff];
+        return ((availability[staff] >> slot) & 1) && !((worked >> slot) & 1) &&
+               !(worked & neighbours(slot)) && __builtin_popcount(worked) < maxShifts;
+    }
+
+    void assign(Roster& roster, int staff, int post, int slot) const {
+        int load = __builtin_popcount(roster.worked[staff]);
+        roster.loadSquares += 2 * load + 1;
+        roster.worked[staff] |= 1u << slot;
+        roster.postAt[staff * ROSTER_SLOTS + slot] = post;
+        if (roster.covered[post * ROSTER_SLOTS + slot]++ < demand[post][slot]) roster.shortfall--;
+    }
+
+    void unassign(Roster& roster, int staff, int slot) const {
+        int post = roster.postAt[staff * ROSTER_SLOTS + slot];
+        int load = __builtin_popcount(roster.worked[staff]);
+        roster.loadSquares -= 2 * load - 1;
+        roster.worked[staff] &= ~(1u << slot);
+        roster.postAt[staff * ROSTER_SLOTS + slot] = -1;
+        if (--roster.covered[post * ROSTER_SLOTS + slot] < demand[post][slot]) roster.shortfall++;
+    }
+
+    Roster greedy() const {
+        Roster roster;
+        roster.worked.assign(availability.size(), 0);
+        roster.postAt.assign(availability.size() * ROSTER_SLOTS, -1);
+        roster.covered.assign(demand.size() * ROSTER_SLOTS, 0);
+        for (const auto& post : demand) {
+            for (int slot = 0; slot < ROSTER_SLOTS; slot++) roster.shortfall += post[slot];
+        }
+
+        vector<int> candidates;
+        for (int slot = 0; slot < ROSTER_SLOTS; slot++) {
+            candidates.clear();
+            for (int staff : availableIn[slot]) {
+                if (eligible(roster, staff, slot)) candidates.push_back(staff);
+            }
+            stable_sort(candidates.begin(), candidates.end(), [&](int a, int b) {
+                return __builtin_popcount(roster.worked[a]) < __builtin_popcount(roster.worked[b]);
+            });
+            size_t next = 0;
+            for (size_t post = 0; post < demand.size(); post++) {
+                for (int need = demand[post][slot]; need > 0 && next < candidates.size(); need--) {
+                    assign(roster, candidates[next++], post, slot);
+                }
+            }
+        }
+        return roster;
+    }
+
+    // A random eligible staff member for the slot from a bounded sample, -1 if none found
+    int sampleEligible(const Roster& roster, int slot, int exclude, int maxLoad, mt19937& rng) const {
+        const vector<int>& pool = availableIn[slot];
+        if (pool.empty()) return -1;
+        for (int tries = 0; tries < 32; tries++) {
+            int staff = pool[rng() % pool.size()];
+            if (staff != exclude && eligible(roster, staff, slot) &&
+                __builtin_popcount(roster.worked[staff]) <= maxLoad) {
+                return staff;
+            }
+        }
+        return -1;
+    }
+
+    // Covers one missing staff-shift, directly or by handing one of a blocked
+    // candidate's other shifts to someone else first
+    bool fillMove(Roster& roster, int post, int slot, mt19937& rng) const {
+        int staff = sampleEligible(roster, slot, -1, maxShifts, rng);
+        if (staff >= 0) {
+            assign(roster, staff, post, slot);
+            return true;
+        }
+        const vector<int>& pool = availableIn[slot];
+        if (pool.empty()) return false;
+        int blocked = pool[rng() % pool.size()];
+        uint32_t worked = roster.worked[blocked];
+        if ((worked >> slot) & 1) return false;
+        uint32_t mustMove = worked & neighbours(slot);
+        if (__builtin_popcount(mustMove) > 1) return false;
+        if (!mustMove) {
+            if (__builtin_popcount(worked) < maxShifts) return false;
+            int pick = rng() % __builtin_popcount(worked);
+            mustMove = worked;
+            while (pick--) mustMove &= mustMove - 1;
+            mustMove &= -mustMove;
+        }
+        int other = __builtin_ctz(mustMove);
+        int replacement = sampleEligible(roster, other, blocked, maxShifts, rng);
+        if (replacement < 0) return false;
+        int otherPost = roster.postAt[blocked * ROSTER_SLOTS + other];
+        unassign(roster, blocked, other);
+        assign(roster, replacement, otherPost, other);
+        if (!eligible(roster, blocked, slot)) {
+            unassign(roster, replacement, other);
+            assign(roster, blocked, otherPost, other);
+            return false;
+        }
+        assign(roster, blocked, post, slot);
+        return true;
+    }
+
+    // Hands one shift from a busy staff member to a less busy one
+    void balanceMove(Roster& roster, mt19937& rng) const {
+        int staff = rng() % availability.size();
+        uint32_t worked = roster.worked[staff];
+        int load = __builtin_popcount(worked);
+        if (load < 2) return;
+        int pick = rng() % load;
+        while (pick--) worked &= worked - 1;
+        int slot = __builtin_ctz(worked);
+        int replacement = sampleEligible(roster, slot, staff, load - 2, rng);
+        if (replacement < 0) return;
+        int post = roster.postAt[staff * ROSTER_SLOTS + slot];
+        unassign(roster, staff, slot);
+        assign(roster, replacement, post, slot);
+    }
+
+    void improve(Roster& roster, int iterations, unsigned seed) const {
+        mt19937 rng(seed);
+        vector<pair<int, int>> deficits;
+        for (int i = 0; i < iterations; i++) {
+            if (roster.shortfall > 0 && i % 2 == 0) {
+                if (deficits.empty()) {
+                    for (size_t post = 0; post < demand.size(); post++) {
+                        for (int slot = 0; slot < ROSTER_SLOTS; slot++) {
+                            if (roster.covered[post * ROSTER_SLOTS + slot] < demand[post][slot]) {
+                                deficits.push_back({post, slot});
+                            }
+                        }
+                    }
+                    shuffle(deficits.begin(), deficits.end(), rng);
+                }
+                pair<int, int> cell = deficits.back();
+                deficits.pop_back();
+                if (roster.covered[cell.first * ROSTER_SLOTS + cell.second] < demand[cell.first][cell.second]) {
+                    fillMove(roster, cell.first, cell.second, rng);
+                }
+            } else {
+                balanceMove(roster, rng);
+            }
+        }
+    }
+
+    vector<Duty> duties(const Roster& roster) const {
+        vector<Duty> result;
+        for (size_t staff = 0; staff < availability.size(); staff++) {
+            for (uint32_t worked = roster.worked[staff]; worked; worked &= worked - 1) {
+                int slot = __builtin_ctz(worked);
+                result.push_back({int(staff), roster.postAt[staff * ROSTER_SLOTS + slot], slot});
+            }
+        }
+        return result;
+    }
+
+public:
+    RosterEngine(vector<uint32_t> staffAvailability, vector<array<uint8_t, ROSTER_SLOTS>> postDemand, int weeklyLimit)
+        : availability(move(staffAvailability)), demand(move(postDemand)), availableIn(ROSTER_SLOTS),
+          maxShifts(weeklyLimit) {
+        for (size_t staff = 0; staff < availability.size(); staff++) {
+            for (int slot = 0; slot < ROSTER_SLOTS; slot++) {
+                if ((availability[staff] >> slot) & 1) availableIn[slot].push_back(staff);
+            }
+        }
+    }
+
+    // Greedy start only when iterations is 0
+    vector<Duty> solve(int threadCount, int iterations) const {
+        Roster start = greedy();
+        if (iterations == 0 || availability.empty()) return duties(start);
+
+        threadCount = max(1, threadCount);
+        vector<Roster> results(threadCount, start);
+        vector<thread> workers;
+        for (int t = 1; t < threadCount; t++) {
+            workers.emplace_back([&, t]() { improve(results[t], iterations, 1000 + t); });
+        }
+        improve(results[0], iterations, 1000);
+        for (thread& worker : workers) worker.join();
+
+        int best = 0;
+        for (int t = 1; t < threadCount; t++) {
+            if (results[t].betterThan(results[best])) best = t;
+        }
+        return duties(results[best]);
+    }
+
+    // Checks any roster, generated or entered by hand, against the rules
+    RosterIssues check(const vector<Duty>& roster) const {
+        RosterIssues issues;
+        vector<uint32_t> worked(availability.size(), 0);
+        vector<uint8_t> covered(demand.size() * ROSTER_SLOTS, 0);
+        vector<Duty> sorted = roster;
+        sort(sorted.begin(), sorted.end(), [](const Duty& a, const Duty& b) {
+            return a.staff != b.staff ? a.staff < b.staff : a.slot < b.slot;
+        });
+        for (const Duty& duty : sorted) {
+            uint32_t bit = 1u << duty.slot;
+            if (worked[duty.staff] & bit) {
+                issues.doubleAssigned.push_back(duty);
+                continue;
+            }
+            if (worked[duty.staff] & neighbours(duty.slot)) issues.restViolations.push_back(duty);
+            if (!(availability[duty.staff] & bit)) issues.unavailable.push_back(duty);
+            worked[duty.staff] |= bit;
+            covered[duty.post * ROSTER_SLOTS + duty.slot]++;
+        }
+        for (size_t staff = 0; staff < worked.size(); staff++) {
+            if (__builtin_popcount(worked[staff]) > maxShifts) issues.overworked.push_back(staff);
+        }
+        for (size_t post = 0; post < demand.size(); post++) {
+            for (int slot = 0; slot < ROSTER_SLOTS; slot++) {
+                int missing = demand[post][slot] - covered[post * ROSTER_SLOTS + slot];
+                if (missing <= 0) continue;
+                issues.understaffed.push_back({post, slot});
+                issues.shortfall += missing;
+            }
+        }
+        return issues;
+    }
+};
+
 class PrisonManagementSystem {
 private:
     vector<Inmate> inmates;
@@ -195,13 +1251,552 @@ private:
     map<string, int> inmateIndex;    // inmateId -> index
     map<string, int> staffIndex;     // staffId -> index
     map<string, int> visitorIndex;   // visitorId -> index
-    map<pair<string, int>, string> cellAssignments; // (block, number) -> inmateId
-
-    bool isCellOccupied(const string& block, int number) const {
-        return cellAssignments.find(make_pair(block, number)) != cellAssignments.end();
+    vector<CellBlock> blocks;
+    map<string, int> blockIndex;     // block name -> index
+    InmateSearchIndex searchIndex;
+    InmateEventStore events;
+    VisitGraph visitGraph;
+    CensusCounters census;
+    ReleaseCalendar releaseCalendar;
+    vector<pair<string, array<uint8_t, SHIFTS_PER_DAY>>> dutyPosts;  // name, staff needed per shift
+    vector<Duty> roster;
+    VisitScheduler visitScheduler{20, 3};   // 20 visitors per session, 3 visits per inmate a week
+    vector<VisitBooking> bookings;
+    unordered_map<int, vector<size_t>> bookingsByInmate;  // inmate -> positions in bookings
+
+    static const int MAX_WEEKLY_SHIFTS = 5;
+
+    RosterEngine makeRosterEngine() const {
+        vector<uint32_t> availability;
+        for (const Staff& member : staff) availability.push_back(shiftAvailability(member.getShift()));
+        vector<array<uint8_t, ROSTER_SLOTS>> demand;
+        for (const auto& post : dutyPosts) {
+            array<uint8_t, ROSTER_SLOTS> perSlot;
+            for (int slot = 0; slot < ROSTER_SLOTS; slot++) perSlot[slot] = post.second[slot % SHIFTS_PER_DAY];
+            demand.push_back(perSlot);
+        }
+        return RosterEngine(availability, demand, MAX_WEEKLY_SHIFTS);
     }
 
 public:
+    // Adds a visitor without prompting; returns false if the ID is taken
+    bool addVisitor(const string& id, const string& name, const string& relation,
+                    const string& phone, const string& address) {
+        if (visitorIndex.find(id) != visitorIndex.end()) {
+            return false;
+        }
+        visitors.emplace_back(id, name, relation, phone, address);
+        visitorIndex[id] = visitors.size() - 1;
+        return true;
+    }
+
+    // Records a visit to an incarcerated inmate; false if either is unknown or released
+    bool recordVisit(const string& visitorId, const string& inmateId) {
+        auto visitorIt = visitorIndex.find(visitorId);
+        auto inmateIt = inmateIndex.find(inmateId);
+        if (visitorIt == visitorIndex.end() || inmateIt == inmateIndex.end() ||
+            inmates[inmateIt->second].getIsReleased()) {
+            return false;
+        }
+        visitors[visitorIt->second].addVisit(inmateId);
+        visitGraph.addVisit(visitorIt->second, inmateIt->second);
+        return true;
+    }
+
+    // Books a visit for a day within BOOKING_DAYS of today; a booked visit
+    // becomes booking number getBookingCount() - 1
+    BookingOutcome bookVisit(const string& visitorId, const string& inmateId, int day, int session, int today) {
+        auto visitorIt = visitorIndex.find(visitorId);
+        auto inmateIt = inmateIndex.find(inmateId);
+        if (visitorIt == visitorIndex.end() || inmateIt == inmateIndex.end() ||
+            inmates[inmateIt->second].getIsReleased()) {
+            return BookingOutcome::NotFound;
+        }
+        BookingOutcome outcome = visitScheduler.book(inmateIt->second, day, session, today);
+        if (outcome == BookingOutcome::Booked) {
+            bookings.push_back({visitorIt->second, inmateIt->second, day, session, false});
+            bookingsByInmate[inmateIt->second].push_back(bookings.size() - 1);
+        }
+        return outcome;
+    }
+
+    // Cancels a booking that has not taken place; false if there is none
+    bool cancelVisit(size_t booking, int today) {
+        if (booking >= bookings.size() || bookings[booking].cancelled || bookings[booking].day < today) return false;
+        VisitBooking& visit = bookings[booking];
+        visitScheduler.cancel(visit.inmate, visit.day, visit.session, today);
+        visit.cancelled = true;
+        return true;
+    }
+
+    size_t getBookingCount() const { return bookings.size(); }
+
+    // Cancels every booking of the inmate that has not taken place
+    void cancelVisitsOf(int inmate, int today) {
+        auto it = bookingsByInmate.find(inmate);
+        if (it == bookingsByInmate.end()) return;
+        for (size_t booking : it->second) cancelVisit(booking, today);
+        bookingsByInmate.erase(it);
+    }
+
+    // Changes the visiting rules; only allowed before any visit is booked
+    bool setVisitRules(int sessionCapacity, int visitsPerWeek) {
+        if (!bookings.empty() || sessionCapacity < 1 || sessionCapacity > 65535 || visitsPerWeek < 1) return false;
+        visitScheduler = VisitScheduler(sessionCapacity, visitsPerWeek);
+        return true;
+    }
+
+    // The same rules checked by counting through every booking, for comparison
+    BookingOutcome checkBookingByScan(const string& inmateId, int day, int session, int today) const {
+        auto inmateIt = inmateIndex.find(inmateId);
+        if (inmateIt == inmateIndex.end() || inmates[inmateIt->second].getIsReleased()) return BookingOutcome::NotFound;
+        if (session < 0 || session >= VISIT_SESSIONS) return BookingOutcome::InvalidSession;
+        if (day < today || day >= today + BOOKING_DAYS) return BookingOutcome::OutsideWindow;
+        int seated = 0, sameWeek = 0;
+        for (const VisitBooking& visit : bookings) {
+            if (visit.cancelled) continue;
+            if (visit.day == day && visit.session == session) seated++;
+            if (visit.inmate == inmateIt->second && weekOfDay(visit.day) == weekOfDay(day)) sameWeek++;
+        }
+        if (seated >= visitScheduler.getCapacity()) return BookingOutcome::SessionFull;
+        if (sameWeek >= visitScheduler.getWeeklyQuota()) return BookingOutcome::QuotaReached;
+        return BookingOutcome::Booked;
+    }
+
+    void displayVisitorAssociations() const {
+        int choice;
+        cout << "\n1. Visitors of an Inmate" << endl;
+        cout << "2. Common Visitors of Two Inmates" << endl;
+        cout << "3. Associates of an Inmate" << endl;
+        cout << "Enter your choice: ";
+        cin >> choice;
+
+        string inmateId, otherId;
+        cout << "Inmate ID: ";
+        cin >> inmateId;
+        auto inmateIt = inmateIndex.find(inmateId);
+        if (inmateIt == inmateIndex.end()) {
+            cout << "Error: Inmate not found!" << endl;
+            return;
+        }
+
+        if (choice == 1 || choice == 2) {
+            vector<uint32_t> found;
+            if (choice == 1) found = visitGraph.visitorsOf(inmateIt->second);
+            else {
+                cout << "Second Inmate ID: ";
+                cin >> otherId;
+                auto otherIt = inmateIndex.find(otherId);
+                if (otherIt == inmateIndex.end()) {
+                    cout << "Error: Inmate not found!" << endl;
+                    return;
+                }
+                found = visitGraph.commonVisitors(inmateIt->second, otherIt->second);
+            }
+            if (found.empty()) cout << "\nNo visitors found." << endl;
+            for (uint32_t visitor : found) {
+                cout << visitors[visitor].getId() << " - " << visitors[visitor].getName() << endl;
+            }
+        } else if (choice == 3) {
+            int hops;
+            cout << "Maximum Hops: ";
+            cin >> hops;
+            auto found = visitGraph.associates(inmateIt->second, hops);
+            if (found.empty()) cout << "\nNo associates found." << endl;
+            for (const auto& associate : found) {
+                cout << inmates[associate.first].getId() << " - " << inmates[associate.first].getName()
+                     << " (" << associate.second << " hop" << (associate.second > 1 ? "s" : "") << ")" << endl;
+            }
+        } else {
+            cout << "Error: Invalid choice!" << endl;
+        }
+    }
+
+    // Records a behavior or medical event against the inmate's current block
+    bool addEvent(const string& inmateId, InmateEventType type, const string& text, time_t when = time(0)) {
+        auto inmateIt = inmateIndex.find(inmateId);
+        if (inmateIt == inmateIndex.end()) return false;
+        auto blockIt = blockIndex.find(inmates[inmateIt->second].getCellBlock());
+        events.append(inmateIt->second, blockIt == blockIndex.end() ? -1 : blockIt->second, type, text, when);
+        return true;
+    }
+
+    // Events between the two dates inclusive, in one block or all when block is empty;
+    // visit(time, inmate index, type, text)
+    template <typename Visitor>
+    bool forEachEvent(const string& fromDate, const string& toDate, const string& block, Visitor visit) const {
+        int from = parseDayNumber(fromDate), to = parseDayNumber(toDate);
+        auto blockIt = blockIndex.find(block);
+        if (from < 0 || to < 0 || (!block.empty() && blockIt == blockIndex.end())) return false;
+        events.forEachInRange(localDayStart(from), localDayStart(to + 1),
+                              block.empty() ? -1 : blockIt->second,
+                              [&](time_t when, int inmate, int, InmateEventType type, const string& text) {
+                                  visit(when, inmate, type, text);
+                              });
+        return true;
+    }
+
+    void displayEventReport() const {
+        string block, fromDate, toDate;
+        cin.ignore();
+        cout << "\nBlock (blank for all): ";
+        getline(cin, block);
+        cout << "From Date (DD/MM/YYYY): ";
+        getline(cin, fromDate);
+        cout << "To Date (DD/MM/YYYY): ";
+        getline(cin, toDate);
+
+        size_t found = 0;
+        bool valid = forEachEvent(fromDate, toDate, block,
+                                  [&](time_t when, int inmate, InmateEventType type, const string& text) {
+            if (found++ == 0) cout << "\n=== Event Report ===" << endl;
+            cout << formatTime(when) << "  " << inmates[inmate].getId() << "  "
+                 << (type == InmateEventType::Behavior ? "Behavior" : "Medical") << ": " << text << endl;
+        });
+        if (!valid) {
+            cout << "Error: Invalid date or block!" << endl;
+            return;
+        }
+        if (found == 0) cout << "\nNo events recorded in that period." << endl;
+    }
+
+    // Adds an inmate without a cell; returns false if the ID is taken
+    bool addInmate(const string& id, const string& name, int age, const string& gender,
+                   const string& crime, const string& sentence, const string& admissionDate,
+                   const string& releaseDate) {
+        if (inmateIndex.find(id) != inmateIndex.end()) {
+            return false;
+        }
+        inmates.emplace_back(id, name, age, gender, crime, sentence, admissionDate, releaseDate);
+        inmateIndex[id] = inmates.size() - 1;
+        searchIndex.add(inmates.size() - 1, name, crime);
+        census.onAdmitted(genderSlot(gender));
+        releaseCalendar.schedule(inmates.size() - 1, parseDayNumber(releaseDate));
+        return true;
+    }
+
+    // Releases an incarcerated inmate, frees the cell and cancels the visits
+    // booked from today on
+    bool releaseInmate(const string& inmateId, int today = localToday()) {
+        auto inmateIt = inmateIndex.find(inmateId);
+        if (inmateIt == inmateIndex.end() || inmates[inmateIt->second].getIsReleased()) {
+            return false;
+        }
+        Inmate& inmate = inmates[inmateIt->second];
+        auto blockIt = blockIndex.find(inmate.getCellBlock());
+        if (blockIt != blockIndex.end()) blocks[blockIt->second].vacate(inmate.getCellNumber());
+        census.onReleased(genderSlot(inmate.getGender()), blockIt == blockIndex.end() ? -1 : blockIt->second);
+        releaseCalendar.remove(inmateIt->second);
+        cancelVisitsOf(inmateIt->second, today);
+        inmate.release();
+        searchIndex.release(inmateIt->second);
+        return true;
+    }
+
+    vector<int> searchByName(const string& query, bool includeReleased) const {
+        vector<int> result = searchIndex.searchName(query, includeReleased);
+        auto idIt = inmateIndex.find(query);
+        if (idIt != inmateIndex.end() && (includeReleased || !inmates[idIt->second].getIsReleased()) &&
+            !binary_search(result.begin(), result.end(), idIt->second)) {
+            result.insert(lower_bound(result.begin(), result.end(), idIt->second), idIt->second);
+        }
+        return result;
+    }
+
+    vector<int> searchByCrime(const string& crime, bool includeReleased) const {
+        return searchIndex.searchCrime(crime, includeReleased);
+    }
+
+    // Current occupants of a block, by cell number
+    vector<int> searchByBlock(const string& block) const {
+        vector<int> result;
+        auto blockIt = blockIndex.find(block);
+        if (blockIt == blockIndex.end()) return result;
+        blocks[blockIt->second].appendOccupants(result);
+        return result;
+    }
+
+    // The original search: substring match over every record, kept for benchmarking
+    vector<int> scanByName(const string& searchTerm) const {
+        vector<int> result;
+        for (size_t i = 0; i < inmates.size(); i++) {
+            if (inmates[i].getName().find(searchTerm) != string::npos || inmates[i].getId() == searchTerm) {
+                result.push_back(i);
+            }
+        }
+        return result;
+    }
+
+    size_t getInmateCount() const { return inmates.size(); }
+
+    // Adds a block of cells numbered 1..capacity; returns false if the name is
+    // taken or empty (unassigned inmates have an empty block) or the settings
+    // are invalid
+    bool addCellBlock(const string& name, int capacity, char gender, int securityLevel) {
+        if (name.empty() || blockIndex.find(name) != blockIndex.end() || capacity < 1 || securityLevel < 1 ||
+            securityLevel > 3 || string("MF*").find(toupper(gender)) == string::npos ||
+            blocks.size() >= size_t(CensusCounters::MAX_BLOCKS)) {
+            return false;
+        }
+        blocks.emplace_back(name, capacity, gender, securityLevel);
+        blockIndex[name] = blocks.size() - 1;
+        census.onBlockAdded();
+        return true;
+    }
+
+    // Puts an unassigned inmate in a specific cell; false if the cell is unknown or taken
+    bool assignCell(int inmate, const string& block, int number) {
+        auto blockIt = blockIndex.find(block);
+        if (inmates[inmate].getIsReleased() || inmates[inmate].getCellNumber() >= 0 ||
+            blockIt == blockIndex.end() || !blocks[blockIt->second].occupy(number, inmate)) {
+            return false;
+        }
+        inmates[inmate].assignCell(block, number);
+        census.onAssigned(genderSlot(inmates[inmate].getGender()), blockIt->second);
+        return true;
+    }
+
+    // First free cell, in block order, of a block that houses the inmate's
+    // gender at or above the security level; false if every such block is full
+    bool autoAssignCell(int inmate, const string& gender, int minSecurityLevel) {
+        if (inmates[inmate].getIsReleased() || inmates[inmate].getCellNumber() >= 0) return false;
+        for (size_t b = 0; b < blocks.size(); b++) {
+            if (!blocks[b].accepts(gender, minSecurityLevel)) continue;
+            int number = blocks[b].firstFreeCell();
+            if (number == 0) continue;
+            blocks[b].occupy(number, inmate);
+            inmates[inmate].assignCell(blocks[b].getName(), number);
+            census.onAssigned(genderSlot(inmates[inmate].getGender()), b);
+            return true;
+        }
+        return false;
+    }
+
+    // (release day, inmate index) for inmates due out within days of today
+    vector<pair<int, int>> getUpcomingReleases(int today, int days) const {
+        return releaseCalendar.dueBetween(today, today + days);
+    }
+
+    // The same list found by parsing every record, kept for benchmarking
+    vector<pair<int, int>> scanUpcomingReleases(int today, int days) const {
+        vector<pair<int, int>> result;
+        for (size_t i = 0; i < inmates.size(); i++) {
+            if (inmates[i].getIsReleased()) continue;
+            int day = parseDayNumber(inmates[i].getReleaseDate());
+            if (day >= today && day <= today + days) result.push_back({day, int(i)});
+        }
+        sort(result.begin(), result.end());
+        return result;
+    }
+
+    // Batch job: releases everyone due on or before the day; returns their IDs
+    vector<string> processDueReleases(int day) {
+        vector<string> released;
+        for (const auto& due : releaseCalendar.dueBy(day)) {
+            string id = inmates[due.second].getId();
+            if (releaseInmate(id)) released.push_back(id);
+        }
+        return released;
+    }
+
+    void displayUpcomingReleases() const {
+        int days;
+        cout << "\nShow releases due within how many days? ";
+        cin >> days;
+
+        int today = localToday();
+        vector<pair<int, int>> due = getUpcomingReleases(today, days);
+        if (due.empty()) {
+            cout << "\nNo releases due in that period." << endl;
+            return;
+        }
+        cout << "\n=== Upcoming Releases ===" << endl;
+        for (const auto& release : due) {
+            const Inmate& inmate = inmates[release.second];
+            cout << formatDate(release.first) << "  " << inmate.getId() << " - " << inmate.getName();
+            if (inmate.getCellNumber() >= 0) cout << " (" << inmate.getCellBlock() << ", cell " << inmate.getCellNumber() << ")";
+            cout << endl;
+        }
+    }
+
+    void processDueReleases() {
+        string date;
+        cin.ignore();
+        cout << "\nProcess releases due up to (DD/MM/YYYY, blank for today): ";
+        getline(cin, date);
+
+        int day = date.empty() ? localToday() : parseDayNumber(date);
+        if (day < 0) {
+            cout << "Error: Invalid date!" << endl;
+            return;
+        }
+        vector<string> released = processDueReleases(day);
+        for (const string& id : released) cout << "Released " << id << endl;
+        cout << "\n" << released.size() << " inmate(s) released." << endl;
+    }
+
+    // Adds a staff member without prompting; returns false if the ID is taken
+    bool addStaff(const string& id, const string& name, const string& position, const string& department,
+                  const string& phone, const string& email, const string& shift) {
+        if (staffIndex.find(id) != staffIndex.end()) {
+            return false;
+        }
+        staff.emplace_back(id, name, position, department, phone, email, shift);
+        staffIndex[id] = staff.size() - 1;
+        return true;
+    }
+
+    // Adds a post staffed every day; returns false if the name is taken
+    bool addDutyPost(const string& name, int morning, int evening, int night) {
+        for (const auto& post : dutyPosts) {
+            if (post.first == name) return false;
+        }
+        if (morning < 0 || evening < 0 || night < 0 || morning > 255 || evening > 255 || night > 255) return false;
+        dutyPosts.push_back({name, {uint8_t(morning), uint8_t(evening), uint8_t(night)}});
+        return true;
+    }
+
+    // Builds and keeps a new weekly roster; returns what it could not satisfy
+    RosterIssues generateRoster(int threadCount, int iterations) {
+        RosterEngine engine = makeRosterEngine();
+        roster = engine.solve(threadCount, iterations);
+        return engine.check(roster);
+    }
+
+    RosterIssues checkRoster() const { return makeRosterEngine().check(roster); }
+
+    void addDutyPost() {
+        string name;
+        int morning, evening, night;
+        cin.ignore();
+        cout << "\nPost Name: ";
+        getline(cin, name);
+        cout << "Staff Needed (Morning Evening Night): ";
+        cin >> morning >> evening >> night;
+
+        if (!addDutyPost(name, morning, evening, night)) {
+            cout << "Error: Post already exists or staffing is invalid!" << endl;
+            return;
+        }
+        cout << "\nDuty post added successfully!" << endl;
+    }
+
+    void generateRoster() {
+        if (dutyPosts.empty() || staff.empty()) {
+            cout << "\nAdd staff and duty posts first." << endl;
+            return;
+        }
+        RosterIssues issues = generateRoster(max(1u, thread::hardware_concurrency()), 200000);
+        cout << "\nRoster generated: " << roster.size() << " duties for " << staff.size() << " staff." << endl;
+        if (issues.understaffed.empty()) {
+            cout << "All posts fully covered." << endl;
+            return;
+        }
+        cout << "Understaffed (" << issues.shortfall << " staff-shifts missing):" << endl;
+        for (const auto& gap : issues.understaffed) {
+            cout << "- " << dutyPosts[gap.first].first << ", " << formatRosterSlot(gap.second) << endl;
+        }
+    }
+
+    CensusSnapshot getCensus() const { return census.snapshot(); }
+
+    // Counts every record from scratch, split across threads, to cross-check the counters
+    CensusSnapshot recountCensus(int threadCount) const {
+        threadCount = max(1, threadCount);
+        vector<CensusSnapshot> partial(threadCount);
+        auto countRange = [&](int t) {
+            CensusSnapshot& counts = partial[t];
+            counts.byBlock.assign(blocks.size(), {0, 0, 0});
+            size_t first = inmates.size() * t / threadCount, last = inmates.size() * (t + 1) / threadCount;
+            for (size_t i = first; i < last; i++) {
+                const Inmate& inmate = inmates[i];
+                if (inmate.getIsReleased()) {
+                    counts.released++;
+                    continue;
+                }
+                int gender = genderSlot(inmate.getGender());
+                counts.incarcerated++;
+                counts.byGender[gender]++;
+                auto blockIt = blockIndex.find(inmate.getCellBlock());
+                if (blockIt == blockIndex.end()) counts.unassigned++;
+                else counts.byBlock[blockIt->second][gender]++;
+            }
+        };
+        vector<thread> workers;
+        for (int t = 1; t < threadCount; t++) workers.emplace_back(countRange, t);
+        countRange(0);
+        for (thread& worker : workers) worker.join();
+
+        CensusSnapshot total = partial[0];
+        for (int t = 1; t < threadCount; t++) {
+            total.incarcerated += partial[t].incarcerated;
+            total.released += partial[t].released;
+            total.unassigned += partial[t].unassigned;
+            for (int g = 0; g < 3; g++) total.byGender[g] += partial[t].byGender[g];
+            for (size_t b = 0; b < blocks.size(); b++) {
+                for (int g = 0; g < 3; g++) total.byBlock[b][g] += partial[t].byBlock[b][g];
+            }
+        }
+        return total;
+    }
+
+    void displayHeadcount() const {
+        CensusSnapshot counts = getCensus();
+        cout << "\n=== Headcount ===" << endl;
+        cout << "Incarcerated: " << counts.incarcerated << " (M " << counts.byGender[0] << ", F "
+             << counts.byGender[1] << ", other " << counts.byGender[2] << ")" << endl;
+        cout << "Without a cell: " << counts.unassigned << endl;
+        cout << "Released: " << counts.released << endl;
+        for (size_t b = 0; b < blocks.size(); b++) {
+            const array<int, 3>& block = counts.byBlock[b];
+            cout << "Block " << blocks[b].getName() << ": " << block[0] + block[1] + block[2] << " (M "
+                 << block[0] << ", F " << block[1] << ", other " << block[2] << ")" << endl;
+        }
+
+        int threadCount = max(1u, thread::hardware_concurrency());
+        if (recountCensus(threadCount) == counts) cout << "\nFull recount agrees." << endl;
+        else cout << "\nWarning: Full recount does not match the counters!" << endl;
+    }
+
+    void addCellBlock() {
+        string name;
+        int capacity, securityLevel;
+        char gender;
+
+        cin.ignore();
+        cout << "\nEnter Cell Block Details" << endl;
+        cout << "Block Name: ";
+        getline(cin, name);
+        cout << "Number of Cells: ";
+        cin >> capacity;
+        cout << "Houses (M/F/* for either): ";
+        cin >> gender;
+        cout << "Security Level (1-3): ";
+        cin >> securityLevel;
+
+        if (!addCellBlock(name, capacity, gender, securityLevel)) {
+            cout << "Error: Block already exists or settings are invalid!" << endl;
+            return;
+        }
+        cout << "\nCell block added successfully!" << endl;
+    }
+
+    void displayCellOccupancy() const {
+        if (blocks.empty()) {
+            cout << "\nNo cell blocks defined." << endl;
+            return;
+        }
+
+        cout << "\n=== Cell Occupancy ===" << endl;
+        for (const CellBlock& block : blocks) {
+            cout << block.getName() << " (" << block.getGender() << ", level " << block.getSecurityLevel()
+                 << "): " << block.getOccupiedCount() << "/" << block.getCapacity() << " occupied";
+            int next = block.firstFreeCell();
+            if (next) cout << ", next free cell " << next;
+            cout << endl;
+        }
+    }
+
     void addInmate() {
         string id, name, gender, crime, sentence, admissionDate, releaseDate;
         int age;
@@ -232,25 +1827,38 @@ public:
         cout << "Release Date (DD/MM/YYYY): ";
         getline(cin, releaseDate);
 
-        inmates.emplace_back(id, name, age, gender, crime, sentence, admissionDate, releaseDate);
-        inmateIndex[id] = inmates.size() - 1;
+        addInmate(id, name, age, gender, crime, sentence, admissionDate, releaseDate);
 
         // Assign cell
-        string block;
-        int number;
+        char autoAssign;
         cout << "\nAssign Cell" << endl;
-        cout << "Block: ";
-        getline(cin, block);
-        cout << "Number: ";
-        cin >> number;
-
-        if (isCellOccupied(block, number)) {
-            cout << "Error: Cell is already occupied!" << endl;
-            return;
+        cout << "Auto-assign first free cell? (Y/N): ";
+        cin >> autoAssign;
+
+        if (toupper(autoAssign) == 'Y') {
+            int securityLevel;
+            cout << "Minimum Security Level (1-3): ";
+            cin >> securityLevel;
+            if (!autoAssignCell(inmates.size() - 1, gender, securityLevel)) {
+                cout << "Error: No free cell in a suitable block!" << endl;
+                return;
+            }
+            cout << "Assigned to " << inmates.back().getCellBlock() << ", cell "
+                 << inmates.back().getCellNumber() << endl;
+        } else {
+            string block;
+            int number;
+            cin.ignore();
+            cout << "Block: ";
+            getline(cin, block);
+            cout << "Number: ";
+            cin >> number;
+
+            if (!assignCell(inmates.size() - 1, block, number)) {
+                cout << "Error: Cell does not exist or is already occupied!" << endl;
+                return;
+            }
         }
-
-        inmates.back().assignCell(block, number);
-        cellAssignments[make_pair(block, number)] = id;
         cout << "\nInmate added successfully!" << endl;
     }
 
@@ -280,8 +1888,7 @@ public:
         cout << "Shift: ";
         getline(cin, shift);
 
-        staff.emplace_back(id, name, position, department, phone, email, shift);
-        staffIndex[id] = staff.size() - 1;
+        addStaff(id, name, position, department, phone, email, shift);
         cout << "\nStaff added successfully!" << endl;
     }
 
@@ -307,8 +1914,7 @@ public:
         cout << "Address: ";
         getline(cin, address);
 
-        visitors.emplace_back(id, name, relation, phone, address);
-        visitorIndex[id] = visitors.size() - 1;
+        addVisitor(id, name, relation, phone, address);
         cout << "\nVisitor added successfully!" << endl;
     }
 
@@ -339,10 +1945,64 @@ public:
             return;
         }
 
-        visitors[visitorIt->second].addVisit(inmateId);
+        recordVisit(visitorId, inmateId);
         cout << "\nVisit recorded successfully!" << endl;
     }
 
+    void bookVisit() {
+        string visitorId, inmateId, date;
+        int session;
+
+        cout << "\nEnter Booking Details" << endl;
+        cout << "Visitor ID: ";
+        cin >> visitorId;
+        cout << "Inmate ID: ";
+        cin >> inmateId;
+        cout << "Date (DD/MM/YYYY): ";
+        cin >> date;
+        cout << "Session (";
+        for (int s = 0; s < VISIT_SESSIONS; s++) cout << (s ? ", " : "") << s + 1 << " = " << formatSession(s);
+        cout << "): ";
+        cin >> session;
+
+        int today = localToday();
+        int day = parseDayNumber(date);
+        switch (bookVisit(visitorId, inmateId, day, session - 1, today)) {
+        case BookingOutcome::Booked:
+            cout << "\nVisit booked, booking number " << bookings.size() << " (" << formatDate(day) << " "
+                 << formatSession(session - 1) << ", " << visitScheduler.seatsLeft(day, session - 1, today)
+                 << " seats left)." << endl;
+            break;
+        case BookingOutcome::NotFound:
+            cout << "Error: Visitor or inmate not found, or inmate released!" << endl;
+            break;
+        case BookingOutcome::InvalidSession:
+            cout << "Error: Session must be between 1 and " << VISIT_SESSIONS << "!" << endl;
+            break;
+        case BookingOutcome::OutsideWindow:
+            cout << "Error: Visits can only be booked for the next " << BOOKING_DAYS << " days!" << endl;
+            break;
+        case BookingOutcome::SessionFull:
+            cout << "Error: That session is full!" << endl;
+            break;
+        case BookingOutcome::QuotaReached:
+            cout << "Error: Inmate has reached " << visitScheduler.getWeeklyQuota() << " visits that week!" << endl;
+            break;
+        }
+    }
+
+    void cancelVisit() {
+        size_t booking;
+        cout << "\nBooking Number: ";
+        cin >> booking;
+
+        if (booking == 0 || !cancelVisit(booking - 1, localToday())) {
+            cout << "Error: No upcoming booking with that number!" << endl;
+            return;
+        }
+        cout << "\nBooking cancelled." << endl;
+    }
+
     void releaseInmate() {
         string inmateId;
         cout << "\nEnter Inmate ID: ";
@@ -354,15 +2014,10 @@ public:
             return;
         }
 
-        Inmate& inmate = inmates[inmateIt->second];
-        if (inmate.getIsReleased()) {
+        if (!releaseInmate(inmateId)) {
             cout << "Error: Inmate has already been released!" << endl;
             return;
         }
-
-        // Remove cell assignment
-        cellAssignments.erase(make_pair(inmate.getCellBlock(), inmate.getCellNumber()));
-        inmate.release();
         cout << "\nInmate released successfully!" << endl;
     }
 
@@ -381,7 +2036,7 @@ public:
         cout << "Enter behavior record: ";
         getline(cin, record);
 
-        inmates[inmateIt->second].addBehaviorRecord(record);
+        addEvent(inmateId, InmateEventType::Behavior, record);
         cout << "\nBehavior record added successfully!" << endl;
     }
 
@@ -400,7 +2055,7 @@ public:
         cout << "Enter medical record: ";
         getline(cin, record);
 
-        inmates[inmateIt->second].addMedicalRecord(record);
+        addEvent(inmateId, InmateEventType::Medical, record);
         cout << "\nMedical record added successfully!" << endl;
     }
 
@@ -415,7 +2070,7 @@ public:
             return;
         }
 
-        inmates[inmateIt->second].displayInfo();
+        inmates[inmateIt->second].displayInfo(events, inmateIt->second);
     }
 
     void displayStaffInfo() {
@@ -430,6 +2085,15 @@ public:
         }
 
         staff[staffIt->second].displayInfo();
+
+        cout << "\nRostered Shifts:" << endl;
+        bool any = false;
+        for (const Duty& duty : roster) {
+            if (duty.staff != staffIt->second) continue;
+            cout << "- " << formatRosterSlot(duty.slot) << ": " << dutyPosts[duty.post].first << endl;
+            any = true;
+        }
+        if (!any) cout << "No rostered shifts." << endl;
     }
 
     void displayVisitorInfo() {
@@ -447,26 +2111,529 @@ public:
     }
 
     void searchInmates() {
+        int searchBy;
+        char includeReleased = 'N';
         string searchTerm;
+
+        cout << "\nSearch by: 1. Name or ID  2. Crime  3. Cell Block" << endl;
+        cout << "Enter your choice: ";
+        cin >> searchBy;
+        if (searchBy != 3) {
+            cout << "Include released inmates? (Y/N): ";
+            cin >> includeReleased;
+        }
         cin.ignore();
-        cout << "\nEnter search term (name or ID): ";
+        cout << "Enter search term: ";
         getline(cin, searchTerm);
 
-        bool found = false;
-        for (const auto& inmate : inmates) {
-            if (inmate.getName().find(searchTerm) != string::npos ||
-                inmate.getId() == searchTerm) {
-                inmate.displayInfo();
-                found = true;
-            }
+        vector<int> found;
+        bool withReleased = toupper(includeReleased) == 'Y';
+        if (searchBy == 1) found = searchByName(searchTerm, withReleased);
+        else if (searchBy == 2) found = searchByCrime(searchTerm, withReleased);
+        else if (searchBy == 3) found = searchByBlock(searchTerm);
+        else {
+            cout << "Error: Invalid search type!" << endl;
+            return;
         }
 
-        if (!found) {
+        if (found.empty()) {
             cout << "\nNo inmates found matching the search term." << endl;
+            return;
+        }
+        for (int inmate : found) {
+            inmates[inmate].displayInfo(events, inmate);
         }
     }
 };
 
+// Benchmark helper: microseconds per query over a batch
+double microsPerQuery(chrono::steady_clock::time_point start, size_t queries) {
+    return chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / max<size_t>(1, queries);
+}
+
+void runSearchBenchmark() {
+    const int inmateCount = 500000;
+    const int queries = 200;
+    const char* firstNames[] = {"Abebe", "Kebede", "Almaz", "Tigist", "Dawit", "Meron", "Yonas", "Selam",
+                                "Bekele", "Hana", "Solomon", "Ruth", "Tesfaye", "Mulu", "Getachew", "Eden"};
+    const char* lastNames[] = {"Tadesse", "Haile", "Girma", "Mengistu", "Alemu", "Wolde", "Bekele", "Tesfaye",
+                               "Assefa", "Desta", "Gebre", "Kassa", "Lemma", "Negash", "Shiferaw", "Worku"};
+    const char* crimes[] = {"Theft", "Robbery", "Fraud", "Assault", "Burglary", "Smuggling", "Homicide",
+                            "Forgery", "Arson", "Embezzlement"};
+
+    PrisonManagementSystem system;
+    system.addCellBlock("A", 60000, '*', 3);
+    system.addCellBlock("B", 60000, '*', 3);
+    mt19937 rng(29);
+    for (int i = 0; i < inmateCount; i++) {
+        string id = "I" + to_string(i);
+        string name = string(firstNames[rng() % 16]) + " " + lastNames[rng() % 16] + " " + to_string(rng() % 1000);
+        system.addInmate(id, name, 20 + rng() % 50, rng() % 2 ? "M" : "F", crimes[rng() % 10], "5 years",
+                         "01/01/2020", "01/01/2025");
+        // Four in five records are historical
+        if (rng() % 5) system.releaseInmate(id);
+        else system.autoAssignCell(i, "M", 1);
+    }
+
+    vector<string> terms;
+    for (int q = 0; q < queries; q++) {
+        terms.push_back(string(firstNames[rng() % 16]) + " " + lastNames[rng() % 16] + " " + to_string(rng() % 1000));
+    }
+
+    auto start = chrono::steady_clock::now();
+    size_t scanned = 0;
+    for (const string& term : terms) scanned += system.scanByName(term).size();
+    double scanUs = microsPerQuery(start, queries);
+
+    start = chrono::steady_clock::now();
+    size_t active = 0;
+    for (const string& term : terms) active += system.searchByName(term, false).size();
+    double activeUs = microsPerQuery(start, queries);
+
+    start = chrono::steady_clock::now();
+    size_t all = 0;
+    for (const string& term : terms) all += system.searchByName(term, true).size();
+    double allUs = microsPerQuery(start, queries);
+
+    start = chrono::steady_clock::now();
+    size_t byCrime = 0;
+    for (int q = 0; q < queries; q++) byCrime += system.searchByCrime(crimes[q % 10], false).size();
+    double crimeUs = microsPerQuery(start, queries);
+
+    cout << "\n" << inmateCount << " inmate records, four in five released, " << queries
+         << " full-name queries" << endl;
+    cout << fixed << setprecision(1);
+    cout << "Substring scan of every record:  " << scanUs << " us/query (" << scanned << " matches)" << endl;
+    cout << "Token index, incarcerated only:  " << activeUs << " us/query (" << active << " matches)" << endl;
+    cout << "Token index, with released:      " << allUs << " us/query (" << all << " matches)" << endl;
+    cout << "Crime index, incarcerated only:  " << crimeUs << " us/query (" << byCrime / queries
+         << " matches per crime)" << endl;
+}
+
+// Reads back the ctime() prefix the old "date: text" records started with
+time_t parseRecordTime(const string& record) {
+    static const string months = "JanFebMarAprMayJunJulAugSepOctNovDec";
+    char weekday[4], month[4];
+    tm when = {};
+    if (sscanf(record.c_str(), "%3s %3s %d %d:%d:%d %d", weekday, month, &when.tm_mday, &when.tm_hour,
+               &when.tm_min, &when.tm_sec, &when.tm_year) != 7) {
+        return -1;
+    }
+    when.tm_mon = months.find(month) / 3;
+    when.tm_year -= 1900;
+    when.tm_isdst = -1;
+    return mktime(&when);
+}
+
+void runEventStoreBenchmark() {
+    const int inmateCount = 20000;
+    const int blockCount = 10;
+    const int eventCount = 1000000;
+    const int queries = 20;
+    const time_t yearStart = 1767225600;  // 01/01/2026
+    const char* incidents[] = {"Fight in yard", "Contraband found", "Refused work detail", "Good conduct",
+                               "Clinic visit: headache", "Clinic visit: dental", "Medication issued"};
+
+    PrisonManagementSystem system;
+    for (int b = 0; b < blockCount; b++) system.addCellBlock(string(1, 'A' + b), inmateCount / blockCount, '*', 3);
+    vector<vector<string>> oldRecords(inmateCount);  // what Inmate used to hold
+    vector<string> oldBlock(inmateCount);
+    mt19937 rng(31);
+    for (int i = 0; i < inmateCount; i++) {
+        system.addInmate("I" + to_string(i), "Inmate", 30, "M", "Theft", "5 years", "01/01/2025", "01/01/2030");
+        system.autoAssignCell(i, "M", 1);
+        oldBlock[i] = string(1, 'A' + i / (inmateCount / blockCount));
+    }
+
+    // Events arrive in time order across the year
+    for (int e = 0; e < eventCount; e++) {
+        int inmate = rng() % inmateCount;
+        int type = rng() % 7;
+        time_t when = yearStart + time_t(e) * (365LL * 86400 / eventCount);
+        system.addEvent("I" + to_string(inmate), type < 4 ? InmateEventType::Behavior : InmateEventType::Medical,
+                        incidents[type], when);
+        oldRecords[inmate].push_back(formatTime(when) + ": " + incidents[type]);
+    }
+
+    vector<pair<string, int>> asks;  // (block, week of year)
+    for (int q = 0; q < queries; q++) asks.push_back({string(1, 'A' + rng() % blockCount), int(rng() % 52)});
+
+    auto start = chrono::steady_clock::now();
+    size_t oldFound = 0;
+    for (const auto& ask : asks) {
+        int day = (yearStart / 86400) + ask.second * 7;
+        time_t from = localDayStart(day), to = localDayStart(day + 7);
+        for (int i = 0; i < inmateCount; i++) {
+            if (oldBlock[i] != ask.first) continue;
+            for (const string& record : oldRecords[i]) {
+                time_t when = parseRecordTime(record);
+                oldFound += when >= from && when < to;
+            }
+        }
+    }
+    double oldUs = microsPerQuery(start, queries);
+
+    start = chrono::steady_clock::now();
+    size_t found = 0;
+    for (const auto& ask : asks) {
+        int day = (yearStart / 86400) + ask.second * 7;
+        system.forEachEvent(formatDate(day), formatDate(day + 6), ask.first,
+                            [&](time_t, int, InmateEventType, const string&) { found++; });
+    }
+    double indexedUs = microsPerQuery(start, queries);
+
+    cout << "\n" << eventCount << " events over a year, " << inmateCount << " inmates in " << blockCount
+         << " blocks; " << queries << " one-week block queries" << endl;
+    cout << fixed << setprecision(1);
+    cout << "Parse every inmate's record strings: " << oldUs << " us/query (" << oldFound << " events)" << endl;
+    cout << "Week-partitioned event store:        " << indexedUs << " us/query (" << found << " events)" << endl;
+}
+
+void runVisitGraphBenchmark() {
+    const int inmateCount = 100000;
+    const int visitorCount = 300000;
+    const int visitCount = 3000000;
+    const int queries = 1000;
+    const int scanQueries = 20;
+
+    // Visitors mostly return to the same one or two inmates
+    mt19937 rng(37);
+    vector<vector<uint32_t>> usual(visitorCount);
+    for (auto& inmates : usual) {
+        inmates.push_back(rng() % inmateCount);
+        if (rng() % 3 == 0) inmates.push_back(rng() % inmateCount);
+    }
+    vector<pair<uint32_t, uint32_t>> visits;
+    for (int v = 0; v < visitCount; v++) {
+        uint32_t visitor = rng() % visitorCount;
+        uint32_t inmate = rng() % 10 ? usual[visitor][rng() % usual[visitor].size()] : rng() % inmateCount;
+        visits.push_back({visitor, inmate});
+    }
+
+    // What Visitor used to hold: inmate IDs per visitor
+    vector<vector<string>> histories(visitorCount);
+    for (const auto& visit : visits) histories[visit.first].push_back("I" + to_string(visit.second));
+
+    auto start = chrono::steady_clock::now();
+    VisitGraph graph;
+    for (const auto& visit : visits) graph.addVisit(visit.first, visit.second);
+    graph.compact();
+    double buildMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    vector<pair<uint32_t, uint32_t>> pairs;  // inmates that share a visitor
+    for (int q = 0; q < queries; q++) {
+        const vector<uint32_t>& known = usual[rng() % visitorCount];
+        pairs.push_back({known[0], known.back()});
+    }
+
+    start = chrono::steady_clock::now();
+    size_t scanCommon = 0;
+    for (int q = 0; q < scanQueries; q++) {
+        string a = "I" + to_string(pairs[q].first), b = "I" + to_string(pairs[q].second);
+        for (const vector<string>& history : histories) {
+            bool sawA = false, sawB = false;
+            for (const string& inmate : history) {
+                sawA = sawA || inmate == a;
+                sawB = sawB || inmate == b;
+            }
+            scanCommon += sawA && sawB;
+        }
+    }
+    double scanUs = microsPerQuery(start, scanQueries);
+
+    size_t checkCommon = 0;
+    for (int q = 0; q < scanQueries; q++) checkCommon += graph.commonVisitors(pairs[q].first, pairs[q].second).size();
+
+    start = chrono::steady_clock::now();
+    size_t reverse = 0;
+    for (int q = 0; q < queries; q++) reverse += graph.visitorsOf(pairs[q].first).size();
+    double reverseUs = microsPerQuery(start, queries);
+
+    start = chrono::steady_clock::now();
+    size_t common = 0;
+    for (int q = 0; q < queries; q++) common += graph.commonVisitors(pairs[q].first, pairs[q].second).size();
+    double commonUs = microsPerQuery(start, queries);
+
+    start = chrono::steady_clock::now();
+    size_t twoHop = 0;
+    for (int q = 0; q < queries / 10; q++) twoHop += graph.associates(pairs[q].first, 2).size();
+    double twoHopUs = microsPerQuery(start, queries / 10);
+
+    cout << "\n" << visitCount << " visits, " << visitorCount << " visitors, " << inmateCount << " inmates ("
+         << graph.getEdgeCount() << " distinct pairs)" << endl;
+    cout << fixed << setprecision(1);
+    cout << "Build with incremental compaction: " << buildMs << " ms" << endl;
+    cout << "Common visitors, scanning every history: " << scanUs << " us/query (" << scanCommon
+         << " found, graph found " << checkCommon << ")" << endl;
+    cout << "Common visitors, graph: " << commonUs << " us/query" << endl;
+    cout << "Visitors of an inmate:  " << reverseUs << " us/query (" << reverse / queries << " on average)" << endl;
+    cout << "Associates within 2 hops: " << twoHopUs << " us/query (" << twoHop / (queries / 10)
+         << " on average)" << endl;
+}
+
+void runCensusBenchmark() {
+    const int inmateCount = 500000;
+    const int blockCount = 50;
+    const int snapshots = 100000;
+
+    PrisonManagementSystem system;
+    for (int b = 0; b < blockCount; b++) system.addCellBlock("B" + to_string(b), 4000, '*', 3);
+    mt19937 rng(41);
+
+    // A roll-call reader takes snapshots while admissions and releases go on,
+    // checking each one adds up
+    atomic<bool> done(false);
+    atomic<long> taken(0), inconsistent(0);
+    thread reader([&]() {
+        while (!done.load()) {
+            CensusSnapshot counts = system.getCensus();
+            int housed = counts.unassigned;
+            for (const auto& block : counts.byBlock) housed += block[0] + block[1] + block[2];
+            inconsistent += housed != counts.incarcerated ||
+                            counts.byGender[0] + counts.byGender[1] + counts.byGender[2] != counts.incarcerated;
+            taken++;
+            this_thread::yield();
+        }
+    });
+    for (int i = 0; i < inmateCount; i++) {
+        string id = "I" + to_string(i);
+        system.addInmate(id, "Inmate", 30, rng() % 4 ? "M" : "F", "Theft", "5 years", "01/01/2020", "01/01/2025");
+        if (rng() % 3) system.releaseInmate(id);
+        else if (rng() % 10) system.autoAssignCell(i, "M", 1);
+    }
+    done = true;
+    reader.join();
+
+    auto start = chrono::steady_clock::now();
+    volatile int sink = 0;  // keeps each read inside the timed region
+    for (int s = 0; s < snapshots; s++) sink = sink + system.getCensus().incarcerated;
+    double snapshotUs = microsPerQuery(start, snapshots);
+
+    start = chrono::steady_clock::now();
+    CensusSnapshot serial = system.recountCensus(1);
+    double serialMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    int threadCount = max(4u, thread::hardware_concurrency());
+    start = chrono::steady_clock::now();
+    CensusSnapshot parallel = system.recountCensus(threadCount);
+    double parallelMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    CensusSnapshot counters = system.getCensus();
+    cout << "\n" << inmateCount << " inmate records in " << blockCount << " blocks: " << counters.incarcerated
+         << " incarcerated, " << counters.unassigned << " without a cell" << endl;
+    cout << fixed << setprecision(2);
+    cout << "Counter snapshot: " << snapshotUs << " us" << endl;
+    cout << "Full recount, 1 thread: " << serialMs << " ms" << endl;
+    cout << "Full recount, " << threadCount << " threads: " << parallelMs << " ms" << endl;
+    cout << "Recounts match counters: " << (serial == counters && parallel == counters ? "yes" : "NO") << endl;
+    cout << "Snapshots taken during updates: " << taken << ", inconsistent: " << inconsistent << endl;
+}
+
+void runReleaseCalendarBenchmark() {
+    const int inmateCount = 500000;
+    const int queries = 50;
+    const int today = parseDayNumber("01/06/2026");
+
+    PrisonManagementSystem system;
+    mt19937 rng(43);
+    for (int i = 0; i < inmateCount; i++) {
+        // Release dates spread over the next ten years, one in twenty a life sentence
+        string releaseDate = rng() % 20 ? formatDate(today + rng() % 3650) : "Life";
+        system.addInmate("I" + to_string(i), "Inmate", 30, "M", "Theft", "Various", "01/01/2020", releaseDate);
+    }
+
+    auto start = chrono::steady_clock::now();
+    size_t scanned = 0;
+    for (int q = 0; q < queries; q++) scanned += system.scanUpcomingReleases(today + q, 7).size();
+    double scanUs = microsPerQuery(start, queries);
+
+    start = chrono::steady_clock::now();
+    size_t found = 0;
+    for (int q = 0; q < queries; q++) found += system.getUpcomingReleases(today + q, 7).size();
+    double calendarUs = microsPerQuery(start, queries);
+
+    start = chrono::steady_clock::now();
+    size_t released = 0;
+    for (int day = today; day < today + 30; day++) released += system.processDueReleases(day).size();
+    double batchMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    cout << "\n" << inmateCount << " inmates, release dates over ten years; " << queries
+         << " due-in-7-days queries" << endl;
+    cout << fixed << setprecision(1);
+    cout << "Parse every record: " << scanUs << " us/query (" << scanned << " due)" << endl;
+    cout << "Release calendar:   " << calendarUs << " us/query (" << found << " due)" << endl;
+    cout << "Daily release job for 30 days: " << batchMs << " ms (" << released << " released)" << endl;
+}
+
+void runRosterBenchmark() {
+    const int staffCount = 5000;
+    const int postCount = 200;
+    const int iterations = 500000;
+    const char* shifts[] = {"Morning", "Evening", "Night", "Any"};
+
+    // Demand close to what the staff can cover within the weekly limit
+    mt19937 rng(47);
+    vector<uint32_t> availability;
+    for (int s = 0; s < staffCount; s++) {
+        uint32_t mask = shiftAvailability(shifts[rng() % 4]);
+        for (int off = 0; off < 2; off++) {
+            int day = rng() % 7;
+            mask &= ~(((1u << SHIFTS_PER_DAY) - 1) << (day * SHIFTS_PER_DAY));
+        }
+        availability.push_back(mask);
+    }
+    vector<array<uint8_t, ROSTER_SLOTS>> demand(postCount);
+    for (auto& post : demand) {
+        int base = 4 + rng() % 5;
+        for (int slot = 0; slot < ROSTER_SLOTS; slot++) post[slot] = slot % SHIFTS_PER_DAY == 2 ? base / 2 + 1 : base;
+    }
+    RosterEngine engine(availability, demand, 5);
+
+    auto start = chrono::steady_clock::now();
+    vector<Duty> greedy = engine.solve(1, 0);
+    double greedyMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    RosterIssues greedyIssues = engine.check(greedy);
+
+    int threadCount = max(4u, thread::hardware_concurrency());
+    start = chrono::steady_clock::now();
+    vector<Duty> improved = engine.solve(threadCount, iterations);
+    double improvedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    RosterIssues improvedIssues = engine.check(improved);
+
+    auto spread = [&](const vector<Duty>& duties) {
+        vector<int> load(staffCount, 0);
+        for (const Duty& duty : duties) load[duty.staff]++;
+        return *max_element(load.begin(), load.end()) - *min_element(load.begin(), load.end());
+    };
+    auto violations = [](const RosterIssues& issues) {
+        return issues.doubleAssigned.size() + issues.restViolations.size() + issues.unavailable.size() +
+               issues.overworked.size();
+    };
+    int totalDemand = 0;
+    for (const auto& post : demand) {
+        for (int slot = 0; slot < ROSTER_SLOTS; slot++) totalDemand += post[slot];
+    }
+
+    cout << "\n" << staffCount << " staff, " << postCount << " posts, " << totalDemand
+         << " staff-shifts needed per week (limit 5 shifts each)" << endl;
+    cout << fixed << setprecision(1);
+    cout << "Greedy: " << greedyMs << " ms, " << greedyIssues.shortfall << " uncovered, workload spread "
+         << spread(greedy) << ", rule violations " << violations(greedyIssues) << endl;
+    cout << "Greedy + local search (" << threadCount << " threads x " << iterations << " moves): " << improvedMs
+         << " ms, " << improvedIssues.shortfall << " uncovered, workload spread " << spread(improved)
+         << ", rule violations " << violations(improvedIssues) << endl;
+}
+
+void runVisitBookingBenchmark() {
+    const int inmateCount = 20000;
+    const int visitorCount = 60000;
+    const int requests = 300000;
+    const int checked = 20000;
+    const int scans = 1000;
+    const int today = parseDayNumber("01/06/2026");
+
+    PrisonManagementSystem system, verified;
+    for (PrisonManagementSystem* target : {&system, &verified}) {
+        target->setVisitRules(1000, 3);
+        for (int i = 0; i < inmateCount; i++) {
+            target->addInmate("I" + to_string(i), "Inmate", 30, "M", "Theft", "Various", "01/01/2020", "Life");
+        }
+        for (int v = 0; v < visitorCount; v++) target->addVisitor("V" + to_string(v), "Visitor", "Family", "555", "Addis");
+    }
+
+    // Requests over the booking window, three in four for a weekend day
+    struct Request {
+        string visitor, inmate;
+        int day, session;
+    };
+    mt19937 rng(48);
+    vector<int> weekdays, weekends;
+    for (int day = today; day < today + BOOKING_DAYS; day++) {
+        bool weekend = weekOfDay(day + 2) != weekOfDay(day);   // Saturday or Sunday
+        (weekend ? weekends : weekdays).push_back(day);
+    }
+    vector<Request> batch;
+    for (int r = 0; r < requests; r++) {
+        const vector<int>& days = rng() % 4 ? weekends : weekdays;
+        batch.push_back({"V" + to_string(rng() % visitorCount), "I" + to_string(rng() % inmateCount),
+                         days[rng() % days.size()], int(rng() % VISIT_SESSIONS)});
+    }
+
+    auto start = chrono::steady_clock::now();
+    size_t outcomes[6] = {0, 0, 0, 0, 0, 0};
+    for (const Request& request : batch) {
+        outcomes[int(system.bookVisit(request.visitor, request.inmate, request.day, request.session, today))]++;
+    }
+    double bookUs = microsPerQuery(start, requests);
+
+    size_t mismatches = 0;
+    for (int r = 0; r < checked; r++) {
+        const Request& request = batch[r];
+        BookingOutcome expected = verified.checkBookingByScan(request.inmate, request.day, request.session, today);
+        mismatches += verified.bookVisit(request.visitor, request.inmate, request.day, request.session, today) != expected;
+    }
+
+    start = chrono::steady_clock::now();
+    volatile size_t scanBooked = 0;
+    for (int q = 0; q < scans; q++) {
+        const Request& request = batch[q];
+        scanBooked = scanBooked + (system.checkBookingByScan(request.inmate, request.day, request.session, today) ==
+                                   BookingOutcome::Booked);
+    }
+    double scanUs = microsPerQuery(start, scans);
+
+    cout << "\n" << inmateCount << " inmates, " << requests << " booking requests over " << BOOKING_DAYS
+         << " days, three in four for a weekend (1000 seats a session, 3 visits a week)" << endl;
+    cout << "Booked " << outcomes[int(BookingOutcome::Booked)] << ", session full "
+         << outcomes[int(BookingOutcome::SessionFull)] << ", quota reached " << outcomes[int(BookingOutcome::QuotaReached)]
+         << endl;
+    cout << fixed << setprecision(2);
+    cout << "Counters: " << bookUs << " us/booking (" << setprecision(0) << 1e6 / bookUs << " bookings/s)" << endl;
+    cout << setprecision(2);
+    cout << "Scan all " << system.getBookingCount() << " bookings: " << scanUs << " us/check" << endl;
+    cout << "Counters vs scan on the first " << checked << " requests: " << mismatches << " mismatches" << endl;
+}
+
+void runBenchmarks() {
+    int choice;
+    cout << "\n=== Benchmarks ===" << endl;
+    cout << "1. Inmate Search (500k records)" << endl;
+    cout << "2. Event Store Block/Week Queries" << endl;
+    cout << "3. Visitor-Inmate Graph (3M visits)" << endl;
+    cout << "4. Census Counters vs Recount" << endl;
+    cout << "5. Release Calendar" << endl;
+    cout << "6. Duty Roster (5k staff x 200 posts)" << endl;
+    cout << "7. Visit Booking" << endl;
+    cout << "Enter your choice: ";
+    cin >> choice;
+
+    switch (choice) {
+        case 1:
+            runSearchBenchmark();
+            break;
+        case 2:
+            runEventStoreBenchmark();
+            break;
+        case 3:
+            runVisitGraphBenchmark();
+            break;
+        case 4:
+            runCensusBenchmark();
+            break;
+        case 5:
+            runReleaseCalendarBenchmark();
+            break;
+        case 6:
+            runRosterBenchmark();
+            break;
+        case 7:
+            runVisitBookingBenchmark();
+            break;
+        default:
+            cout << "\nInvalid choice!" << endl;
+    }
+}
+
 int main() {
     PrisonManagementSystem system;
     int choice;
@@ -486,8 +2653,20 @@ int main() {
         cout << "9. Display Staff Information" << endl;
         cout << "10. Display Visitor Information" << endl;
         cout << "11. Search Inmates" << endl;
-        cout << "12. Exit" << endl;
-        cout << "Enter your choice (1-12): ";
+        cout << "12. Add Cell Block" << endl;
+        cout << "13. Cell Occupancy" << endl;
+        cout << "14. Event Report" << endl;
+        cout << "15. Visitor Associations" << endl;
+        cout << "16. Headcount" << endl;
+        cout << "17. Upcoming Releases" << endl;
+        cout << "18. Process Due Releases" << endl;
+        cout << "19. Add Duty Post" << endl;
+        cout << "20. Generate Duty Roster" << endl;
+        cout << "21. Book Visit" << endl;
+        cout << "22. Cancel Visit Booking" << endl;
+        cout << "23. Benchmarks" << endl;
+        cout << "24. Exit" << endl;
+        cout << "Enter your choice (1-24): ";
         cin >> choice;
 
         switch (choice) {
@@ -525,6 +2704,42 @@ int main() {
                 system.searchInmates();
                 break;
             case 12:
+                system.addCellBlock();
+                break;
+            case 13:
+                system.displayCellOccupancy();
+                break;
+            case 14:
+                system.displayEventReport();
+                break;
+            case 15:
+                system.displayVisitorAssociations();
+                break;
+            case 16:
+                system.displayHeadcount();
+                break;
+            case 17:
+                system.displayUpcomingReleases();
+                break;
+            case 18:
+                system.processDueReleases();
+                break;
+            case 19:
+                system.addDutyPost();
+                break;
+            case 20:
+                system.generateRoster();
+                break;
+            case 21:
+                system.bookVisit();
+                break;
+            case 22:
+                system.cancelVisit();
+                break;
+            case 23:
+                runBenchmarks();
+                break;
+            case 24:
                 cout << "\nThank you for using Prison Management System!" << endl;
                 return 0;
             default: